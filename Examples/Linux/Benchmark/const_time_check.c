@@ -0,0 +1,437 @@
+/**
+  ******************************************************************************
+  * File Name          : const_time_check.c
+  * Description        : Check of data independent integer compensation
+  ******************************************************************************
+  *
+  * Program calls BME280_CompensateTemp, BME280_CompensatePress and
+  * BME280_CompensateHum for every adc value (adc_T and adc_P over full
+  * 20-bit range, adc_H over full 16-bit range, adc_P and adc_H at TEMPS_NR
+  * temperatures from -40 to 85 degC) on simulated sensor (mock_bus.h) and
+  * measures every call in two deterministic ways:
+  * - path of basic blocks of bme280.c (number of blocks and hash of their
+  *   addresses), bme280.c must be built with -fsanitize-coverage=trace-pc,
+  * - retired user instructions and branches read from perf counters, when
+  *   kernel gives access to them (perf_event_paranoid, virtual machines).
+  * Check fails (exit code 1) when any input gives other count or path than
+  * the first input of the same function. Timing (best of RUNS_NR calls per
+  * input, TSC cycles on x86 or ns on other hosts) is printed for reference
+  * only. Hash of all results must be the same with and without
+  * USE_CONST_TIME (results are bit-identical):
+  * gcc -O2 -fsanitize-coverage=trace-pc -I../../.. -c ../../../bme280.c
+  * gcc -O2 -I../../.. const_time_check.c bme280.o -o default
+  * gcc -O2 -DUSE_CONST_TIME -fsanitize-coverage=trace-pc -I../../.. -c ../../../bme280.c
+  * gcc -O2 -DUSE_CONST_TIME -I../../.. const_time_check.c bme280.o -o const_time
+  * Default 32-bit build fails (branches around pressure division), default
+  * 64-bit build passes on x86-64 where compiler emits conditional moves, but
+  * equal counts do not prove equal time there: hardware divider is a single
+  * instruction with data dependent latency, which only USE_CONST_TIME removes.
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TIME_UNIT		"cycles"
+#else
+#define TIME_UNIT		"ns"
+#endif
+
+/* public defines */
+#define RUNS_NR			(5U)
+#define TEMPS_NR		(9U)		// temperatures of pressure and humidity sweep
+#define ADC_MAX			(0xFFFFFL)	// max. 20-bit adc_T and adc_P
+#define ADC_H_MAX		(0xFFFFL)	// max. 16-bit adc_H
+#define INPUTS_NR		(TEMPS_NR * (ADC_MAX + 1UL))	// max. inputs of single function
+#define FNV_OFFSET		(2166136261UL)
+#define FNV_PRIME		(16777619UL)
+
+/* public types */
+typedef enum {
+
+	func_temp = 0,
+	func_press,
+	func_hum
+
+} func_t;
+
+typedef struct {
+
+	uint64_t blocks;	// basic blocks of bme280.c executed in single call
+	uint32_t path;		// hash of addresses of these blocks
+	uint64_t instr;		// retired user instructions (perf)
+	uint64_t branches;	// retired user branches (perf)
+
+} cost_t;
+
+typedef struct {
+
+	const char *name;
+	uint32_t count;
+	cost_t ref;			// cost of first input
+	uint32_t differ;	// inputs with other cost than first one
+	BME280_S32_t adc;	// first input with other cost
+	int32_t temp;		// and its temperature (0.01 degC)
+	cost_t cost;		// and its cost
+	uint32_t min;
+	uint32_t median;
+	uint32_t max;
+
+} result_t;
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+
+static const int32_t temps[TEMPS_NR] = { -4000, -2500, -1000, 0, 1500, 2500, 4000, 6000, 8500 };	// 0.01 degC
+uint32_t times[INPUTS_NR];
+uint32_t hash = FNV_OFFSET;
+int perf_fd = -1;
+volatile uint8_t tracing;
+uint64_t trace_blocks;
+uint32_t trace_path;
+
+/* function prototypes */
+void __sanitizer_cov_trace_pc(void);
+void perf_open(void);
+uint32_t now(void);
+void hash_add(uint32_t value);
+int compare(const void *a, const void *b);
+uint32_t compensate(func_t func, BME280_S32_t adc);
+void measure(func_t func, BME280_S32_t adc, cost_t *cost);
+uint32_t best_time(func_t func, BME280_S32_t adc);
+void result_init(result_t *res, const char *name);
+void result_add(result_t *res, func_t func, BME280_S32_t adc, int32_t temp, uint32_t n);
+void summary(result_t *res);
+void result_print(const result_t *res);
+int32_t find_adc_t(int32_t temp);
+
+
+	/* main */
+int main(void){
+
+	result_t res[3];
+	int32_t adc, temp, t_adcs[TEMPS_NR];
+	uint32_t n;
+	uint8_t i, failed = 0;
+
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+	mock_power_on();
+
+	if(BME280_OK != BME280_Init(&bme, &bme_driver)){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	perf_open();
+	for(i = 0; i < TEMPS_NR; i++) t_adcs[i] = find_adc_t(temps[i]);
+
+	/* temperature, every adc_T */
+	result_init(&res[0], "BME280_CompensateTemp");
+	n = 0;
+	for(adc = 0; adc <= ADC_MAX; adc++){
+
+		BME280_CompensateTemp(&bme, adc, &temp);
+		result_add(&res[0], func_temp, adc, temp, n++);
+	}
+	summary(&res[0]);
+
+	/* pressure, every adc_P */
+	result_init(&res[1], "BME280_CompensatePress");
+	n = 0;
+	for(i = 0; i < TEMPS_NR; i++){
+
+		for(adc = 0; adc <= ADC_MAX; adc++){
+
+			BME280_CompensateTemp(&bme, t_adcs[i], &temp);
+			result_add(&res[1], func_press, adc, temp, n++);
+		}
+	}
+	summary(&res[1]);
+
+	/* humidity, every adc_H */
+	result_init(&res[2], "BME280_CompensateHum");
+	n = 0;
+	for(i = 0; i < TEMPS_NR; i++){
+
+		for(adc = 0; adc <= ADC_H_MAX; adc++){
+
+			BME280_CompensateTemp(&bme, t_adcs[i], &temp);
+			result_add(&res[2], func_hum, adc, temp, n++);
+		}
+	}
+	summary(&res[2]);
+
+#ifdef USE_CONST_TIME
+	printf("USE_CONST_TIME, ");
+#else
+	printf("default, ");
+#endif
+#ifdef USE_64BIT
+	printf("64-bit\n");
+#else
+	printf("32-bit\n");
+#endif
+	if(perf_fd < 0) printf("perf counters not available, instructions and branches not counted\n");
+	if(0 == res[0].ref.blocks) printf("bme280.c not built with -fsanitize-coverage=trace-pc, paths not checked\n");
+	if( (perf_fd < 0) && (0 == res[0].ref.blocks) ){
+
+		printf("nothing to measure\n");
+		return 2;
+	}
+
+	printf("  %-24s %8s %8s %8s %8s %8s\n", "function", "inputs", "blocks", "instr", "branches", "differ");
+	for(i = 0; i < 3; i++){
+
+		printf("  %-24s %8u %8llu %8llu %8llu %8u\n", res[i].name, res[i].count, (unsigned long long)res[i].ref.blocks,
+				(unsigned long long)res[i].ref.instr, (unsigned long long)res[i].ref.branches, res[i].differ);
+	}
+	for(i = 0; i < 3; i++){
+
+		if(0 == res[i].differ) continue;
+		failed = 1;
+		result_print(&res[i]);
+	}
+
+	printf("%s per call (best of %u runs per input, for reference only):\n", TIME_UNIT, RUNS_NR);
+	printf("  %-24s %8s %8s %8s %8s\n", "function", "min", "median", "max", "jitter");
+	for(i = 0; i < 3; i++){
+
+		printf("  %-24s %8u %8u %8u %8u\n", res[i].name, res[i].min, res[i].median, res[i].max,
+				res[i].max - res[i].min);
+	}
+	printf("results hash 0x%08X\n", hash);
+	printf("%s\n", failed ? "FAIL: cost depends on input" : "PASS: cost does not depend on input");
+
+	return failed;
+}
+
+
+	/* function is called by code built with -fsanitize-coverage=trace-pc at every basic block */
+void __sanitizer_cov_trace_pc(void){
+
+	uintptr_t pc;
+	uint8_t i;
+
+	if(0 == tracing) return;
+
+	pc = (uintptr_t)__builtin_return_address(0);
+	trace_blocks++;
+	for(i = 0; i < sizeof(pc); i++){
+
+		trace_path ^= (uint32_t)((pc >> (8 * i)) & 0xFF);
+		trace_path *= FNV_PRIME;
+	}
+}
+
+	/* function opens group of user instructions and branches counters */
+void perf_open(void){
+
+	struct perf_event_attr attr;
+	int fd;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+
+	perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	if(perf_fd < 0) return;
+
+	attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+	attr.disabled = 0;
+	fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, perf_fd, 0);
+	if(fd < 0){
+
+		close(perf_fd);
+		perf_fd = -1;
+	}
+}
+
+	/* function returns current time */
+uint32_t now(void){
+
+#if defined(__x86_64__) || defined(__i386__)
+	uint64_t t;
+
+	_mm_lfence();
+	t = __rdtsc();
+	_mm_lfence();
+
+	return (uint32_t)t;
+#else
+	return (uint32_t)mock_now_ns();
+#endif
+}
+
+	/* function adds value to FNV-1a hash */
+void hash_add(uint32_t value){
+
+	uint8_t i;
+
+	for(i = 0; i < 4; i++){
+
+		hash ^= (value >> (8 * i)) & 0xFF;
+		hash *= FNV_PRIME;
+	}
+}
+
+	/* qsort comparator */
+int compare(const void *a, const void *b){
+
+	uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+	/* function calls compensation of single channel */
+uint32_t compensate(func_t func, BME280_S32_t adc){
+
+	BME280_S32_t temp = 0;
+	BME280_U32_t value = 0;
+
+	switch(func){
+
+	case func_temp:
+		BME280_CompensateTemp(&bme, adc, &temp);
+		return (uint32_t)temp;
+
+	case func_press:
+		BME280_CompensatePress(&bme, adc, &value);
+		return value;
+
+	default:
+		BME280_CompensateHum(&bme, adc, &value);
+		return value;
+	}
+}
+
+	/* function measures path, instructions and branches of single call */
+void measure(func_t func, BME280_S32_t adc, cost_t *cost){
+
+	uint64_t counters[3] = { 0 };	// number of counters, instructions, branches
+
+	trace_blocks = 0;
+	trace_path = FNV_OFFSET;
+	tracing = 1;
+	if(perf_fd >= 0){
+
+		ioctl(perf_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+
+	hash_add(compensate(func, adc));
+
+	if(perf_fd >= 0){
+
+		ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		if(sizeof(counters) != read(perf_fd, counters, sizeof(counters))) memset(counters, 0, sizeof(counters));
+	}
+	tracing = 0;
+
+	cost->blocks = trace_blocks;
+	cost->path = trace_path;
+	cost->instr = counters[1];
+	cost->branches = counters[2];
+}
+
+	/* function returns best time of single call */
+uint32_t best_time(func_t func, BME280_S32_t adc){
+
+	uint32_t begin, t, best = UINT32_MAX;
+	uint8_t i;
+
+	for(i = 0; i < RUNS_NR; i++){
+
+		begin = now();
+		compensate(func, adc);
+		t = now() - begin;
+		if(t < best) best = t;
+	}
+
+	return best;
+}
+
+	/* function clears result of single function */
+void result_init(result_t *res, const char *name){
+
+	memset(res, 0, sizeof(*res));
+	res->name = name;
+}
+
+	/* function measures n-th input of single function */
+void result_add(result_t *res, func_t func, BME280_S32_t adc, int32_t temp, uint32_t n){
+
+	cost_t cost;
+
+	measure(func, adc, &cost);
+	times[n] = best_time(func, adc);
+
+	if(0 == n) res->ref = cost;
+	else if( (cost.blocks != res->ref.blocks) || (cost.path != res->ref.path) ||
+			(cost.instr != res->ref.instr) || (cost.branches != res->ref.branches) ){
+
+		if(0 == res->differ){
+
+			res->adc = adc;
+			res->temp = temp;
+			res->cost = cost;
+		}
+		res->differ++;
+	}
+	res->count = n + 1;
+}
+
+	/* function sorts times of single function and stores min, median and max */
+void summary(result_t *res){
+
+	qsort(times, res->count, sizeof(times[0]), compare);
+
+	res->min = times[0];
+	res->median = times[res->count / 2];
+	res->max = times[res->count - 1];
+}
+
+	/* function prints first input with other cost than first one */
+void result_print(const result_t *res){
+
+	printf("%s: %u inputs differ, first adc 0x%05X at %.2f degC: blocks %llu (path 0x%08X), instr %llu, "
+			"branches %llu, expected blocks %llu (path 0x%08X), instr %llu, branches %llu\n", res->name, res->differ,
+			(unsigned)res->adc, res->temp / 100.0, (unsigned long long)res->cost.blocks,
+			res->cost.path, (unsigned long long)res->cost.instr, (unsigned long long)res->cost.branches,
+			(unsigned long long)res->ref.blocks, res->ref.path, (unsigned long long)res->ref.instr,
+			(unsigned long long)res->ref.branches);
+}
+
+	/* function returns first adc_T with temperature not lower than "temp" */
+int32_t find_adc_t(int32_t temp){
+
+	BME280_S32_t adc_T, t;
+
+	for(adc_T = 0; adc_T < ADC_MAX; adc_T++){
+
+		BME280_CompensateTemp(&bme, adc_T, &t);
+		if(t >= temp) break;
+	}
+
+	return adc_T;
+}
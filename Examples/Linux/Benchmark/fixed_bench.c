@@ -0,0 +1,132 @@
+/**
+  ******************************************************************************
+  * File Name          : fixed_bench.c
+  * Description        : Benchmark of native fixed-point read API
+  ******************************************************************************
+  *
+  * Program compares BME280_ReadAllLast (results converted to integer and
+  * fractional parts) with BME280_ReadAllLast_Q (native fixed-point results)
+  * on simulated sensor (mock_bus.h), no hardware is needed. Time per sample
+  * is measured on host, cost of conversion on Cortex-M0 is estimated from
+  * number of divisions: M0 has no divider and every division or division
+  * with modulo by constant is a call of __aeabi_uidivmod/__aeabi_idivmod,
+  * M0_DIV_CYCLES is assumed cost of single call (define other value for your
+  * toolchain with -DM0_DIV_CYCLES=x).
+  * Build: gcc -O2 -I../../.. fixed_bench.c ../../../bme280.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if !defined(USE_INTEGER_RESULTS) || !defined(USE_FIXED_RESULTS) || !defined(USE_NORMAL_MODE)
+#error "USE_INTEGER_RESULTS, USE_FIXED_RESULTS and USE_NORMAL_MODE must be set in bme280.h"
+#endif
+
+/* public defines */
+#define SAMPLES_NR		(1000000UL)
+#define RUNS_NR			(7U)
+#ifndef M0_DIV_CYCLES
+#define M0_DIV_CYCLES	(60U)
+#endif
+#ifdef USE_64BIT
+#define DIV_CALLS		(3U)	// temperature /100 %100, pressure /10000 %10000, /10
+#else
+#define DIV_CALLS		(2U)	// temperature /100 %100, pressure /100 %100
+#endif
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+/* function prototypes */
+double bench_struct(void);
+double bench_q(void);
+
+
+	/* main */
+int main(void){
+
+	double t_struct = 1e9, t_q = 1e9, t;
+	uint8_t i;
+
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+	mock_power_on();
+
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.mode = BME280_NORMALMODE;
+
+	if( (BME280_OK != BME280_Init(&bme, &bme_driver)) ||
+			(BME280_OK != BME280_ConfigureAll(&bme, &bme_config)) ){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	/* best of RUNS_NR runs */
+	for(i = 0; i < RUNS_NR; i++){
+
+		t = bench_struct();
+		if(t < t_struct) t_struct = t;
+		t = bench_q();
+		if(t < t_q) t_q = t;
+	}
+
+	printf("host, ns per sample (bus simulated in RAM, best of %u runs):\n", RUNS_NR);
+	printf("  BME280_ReadAllLast    %6.1f\n", t_struct);
+	printf("  BME280_ReadAllLast_Q  %6.1f\n", t_q);
+	printf("  saved                 %6.1f\n", t_struct - t_q);
+	printf("Cortex-M0 model, conversion per sample:\n");
+	printf("  BME280_ReadAllLast    %u divisions, ~%u cycles\n", DIV_CALLS, DIV_CALLS * M0_DIV_CYCLES);
+	printf("  BME280_ReadAllLast_Q  0 divisions, 0 cycles\n");
+
+	return 0;
+}
+
+
+	/* function returns ns per sample of BME280_ReadAllLast */
+double bench_struct(void){
+
+	BME280_Data_t data;
+	uint64_t begin;
+	uint32_t i, sum = 0;
+
+	begin = mock_now_ns();
+	for(i = 0; i < SAMPLES_NR; i++){
+
+		mock_set_adc(MOCK_ADC_P + (i & 0x3FF), MOCK_ADC_T + (i & 0xFF), MOCK_ADC_H + (i & 0x7F));
+		BME280_ReadAllLast(&bme, &data);
+		sum += data.pressure_fract + data.temp_fract + data.humidity_fract;
+	}
+
+	if(1 == sum) printf(" ");
+	return (double)(mock_now_ns() - begin) / SAMPLES_NR;
+}
+
+	/* function returns ns per sample of BME280_ReadAllLast_Q */
+double bench_q(void){
+
+	BME280_DataQ_t data;
+	uint64_t begin;
+	uint32_t i, sum = 0;
+
+	begin = mock_now_ns();
+	for(i = 0; i < SAMPLES_NR; i++){
+
+		mock_set_adc(MOCK_ADC_P + (i & 0x3FF), MOCK_ADC_T + (i & 0xFF), MOCK_ADC_H + (i & 0x7F));
+		BME280_ReadAllLast_Q(&bme, &data);
+		sum += data.press + (uint32_t)data.temp + data.hum;
+	}
+
+	if(1 == sum) printf(" ");
+	return (double)(mock_now_ns() - begin) / SAMPLES_NR;
+}
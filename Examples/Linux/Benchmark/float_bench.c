@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * File Name          : float_bench.c
+  * Description        : Benchmark of floating point read API
+  ******************************************************************************
+  *
+  * Program measures time per sample of BME280_ReadAllLast_F on simulated
+  * sensor (mock_bus.h). Build it twice, with integer compensation converted
+  * to floats (default) and with USE_FLOAT_COMPENSATION, and compare results:
+  * gcc -O2 -I../../.. float_bench.c ../../../bme280.c -lm -o bench_int
+  * gcc -O2 -DUSE_FLOAT_COMPENSATION -I../../.. float_bench.c ../../../bme280.c -lm -o bench_float
+  * Host has hardware divider and double precision FPU, so run it on target
+  * (f.e. Cortex-M4F with single precision FPU) to see the gain of the switch.
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if !defined(USE_FLOATS_RESULTS) || !defined(USE_NORMAL_MODE)
+#error "USE_FLOATS_RESULTS and USE_NORMAL_MODE must be set in bme280.h"
+#endif
+
+/* public defines */
+#define SAMPLES_NR		(1000000UL)
+#define RUNS_NR			(7U)
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+/* function prototypes */
+double bench(void);
+
+
+	/* main */
+int main(void){
+
+	double t_min = 1e9, t;
+	uint8_t i;
+
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+	mock_power_on();
+
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.mode = BME280_NORMALMODE;
+
+	if( (BME280_OK != BME280_Init(&bme, &bme_driver)) ||
+			(BME280_OK != BME280_ConfigureAll(&bme, &bme_config)) ){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	/* best of RUNS_NR runs */
+	for(i = 0; i < RUNS_NR; i++){
+
+		t = bench();
+		if(t < t_min) t_min = t;
+	}
+
+#ifdef USE_FLOAT_COMPENSATION
+	printf("float compensation, ns per read (best of %u runs):\n", RUNS_NR);
+#else
+	printf("integer compensation converted to floats, ns per read (best of %u runs):\n", RUNS_NR);
+#endif
+	printf("  BME280_ReadAllLast_F  %6.1f\n", t_min);
+
+	return 0;
+}
+
+
+	/* function returns ns per read */
+double bench(void){
+
+	BME280_DataF_t data;
+	uint64_t begin;
+	uint32_t i;
+	float sum = 0.0F;
+
+	begin = mock_now_ns();
+	for(i = 0; i < SAMPLES_NR; i++){
+
+		mock_set_adc(MOCK_ADC_P + (i & 0x3FF), MOCK_ADC_T + (i & 0xFF), MOCK_ADC_H + (i & 0x7F));
+		BME280_ReadAllLast_F(&bme, &data);
+		sum += data.press + data.temp + data.hum;
+	}
+
+	if(1.0F == sum) printf(" ");
+	return (double)(mock_now_ns() - begin) / SAMPLES_NR;
+}
@@ -0,0 +1,149 @@
+/**
+  ******************************************************************************
+  * File Name          : float_check.c
+  * Description        : Accuracy check of floating point compensation
+  ******************************************************************************
+  *
+  * Program compares results of BME280_ReadAllLast_F compensated with floats
+  * (USE_FLOAT_COMPENSATION) with integer compensation (BME280_ReadAllLast_Q
+  * of the same adc values) on simulated sensor (mock_bus.h). Temperature is swept over -40..85 degC, pressure over
+  * 300..1100 hPa and humidity over whole range, both at TEMPS_NR temperatures.
+  * Max. errors are printed and program returns 1 if any of them is above
+  * bound documented in bme280.h.
+  * Build: gcc -O2 -DUSE_FLOAT_COMPENSATION -I../../.. float_check.c ../../../bme280.c -lm
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if !defined(USE_FLOAT_COMPENSATION) || !defined(USE_FIXED_RESULTS) || !defined(USE_NORMAL_MODE)
+#error "USE_FLOAT_COMPENSATION, USE_FIXED_RESULTS and USE_NORMAL_MODE must be set"
+#endif
+
+/* public defines */
+#define TEMP_BOUND		(0.02)		// deg C
+#define PRESS_BOUND		(0.001)		// hPa
+#define HUM_BOUND		(0.01)		// %RH
+#define TEMPS_NR		(25U)		// temperatures of pressure and humidity sweeps (-40..80 degC every 5 degC)
+#define ADC_T_MIN		(0x00000L)
+#define ADC_T_MAX		(0xFFFFFL)
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+/* function prototypes */
+int8_t read_q(int32_t adc_P, int32_t adc_T, int32_t adc_H, BME280_DataQ_t *data);
+int8_t check_point(int32_t adc_P, int32_t adc_T, int32_t adc_H, double *t_err, double *p_err, double *h_err);
+
+
+	/* main */
+int main(void){
+
+	double t_err, p_err, h_err, t_max = 0.0, p_max = 0.0, h_max = 0.0;
+	int32_t adc_T, adc_P, adc_H, temps[TEMPS_NR], temp;
+	BME280_DataQ_t q;
+	uint32_t t_points = 0, p_points = 0, h_points = 0;
+	uint8_t i;
+
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+	mock_power_on();
+
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.mode = BME280_NORMALMODE;
+
+	if( (BME280_OK != BME280_Init(&bme, &bme_driver)) ||
+			(BME280_OK != BME280_ConfigureAll(&bme, &bme_config)) ){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	/* temperature, every adc_T count in -40..85 degC, grid of temperatures for other channels */
+	i = 0;
+	for(adc_T = ADC_T_MIN; adc_T < ADC_T_MAX; adc_T++){
+
+		if(BME280_OK != read_q(MOCK_ADC_P, adc_T, MOCK_ADC_H, &q)) return 1;
+		temp = q.temp;
+		if( (temp < -4000) || (temp > 8500) ) continue;
+
+		if( (i < TEMPS_NR) && (temp >= (-4000 + (int32_t)i * 500)) ) temps[i++] = adc_T;
+		if(BME280_OK != check_point(MOCK_ADC_P, adc_T, MOCK_ADC_H, &t_err, &p_err, &h_err)) return 1;
+		if(t_err > t_max) t_max = t_err;
+		t_points++;
+	}
+	if(TEMPS_NR != i) return 1;
+
+	/* pressure and humidity at every temperature of grid */
+	for(i = 0; i < TEMPS_NR; i++){
+
+		for(adc_P = 0x30000L; adc_P < 0xF0000L; adc_P += 7){
+
+			if(BME280_OK != check_point(adc_P, temps[i], MOCK_ADC_H, &t_err, &p_err, &h_err)) return 1;
+			if(p_err < 0.0) continue;
+			if(p_err > p_max) p_max = p_err;
+			p_points++;
+		}
+
+		for(adc_H = 0; adc_H <= 0xFFFF; adc_H++){
+
+			if(BME280_OK != check_point(MOCK_ADC_P, temps[i], adc_H, &t_err, &p_err, &h_err)) return 1;
+			if(h_err > h_max) h_max = h_err;
+			h_points++;
+		}
+	}
+
+	printf("max. error of float compensation (points checked):\n");
+	printf("  temperature %.5f degC (%u), bound %.3f\n", t_max, t_points, TEMP_BOUND);
+	printf("  pressure    %.5f hPa (%u), bound %.3f\n", p_max, p_points, PRESS_BOUND);
+	printf("  humidity    %.5f %%RH (%u), bound %.3f\n", h_max, h_points, HUM_BOUND);
+
+	if( (t_max > TEMP_BOUND) || (p_max > PRESS_BOUND) || (h_max > HUM_BOUND) ){
+
+		printf("FAILED\n");
+		return 1;
+	}
+
+	printf("OK\n");
+	return 0;
+}
+
+
+	/* function reads integer results of single set of adc values */
+int8_t read_q(int32_t adc_P, int32_t adc_T, int32_t adc_H, BME280_DataQ_t *data){
+
+	mock_set_adc(adc_P, adc_T, adc_H);
+	if(BME280_OK != BME280_ReadAllLast_Q(&bme, data)) return BME280_INTERFACE_ERR;
+
+	return BME280_OK;
+}
+
+	/* function compares float and integer results of single set of adc values, pressure error is
+	 * negative if pressure is outside 300..1100 hPa */
+int8_t check_point(int32_t adc_P, int32_t adc_T, int32_t adc_H, double *t_err, double *p_err, double *h_err){
+
+	BME280_DataF_t data;
+	BME280_DataQ_t q;
+	double p;
+
+	if(BME280_OK != read_q(adc_P, adc_T, adc_H, &q)) return BME280_INTERFACE_ERR;
+	if(BME280_OK != BME280_ReadAllLast_F(&bme, &data)) return BME280_INTERFACE_ERR;
+
+	p = (double)q.press / (double)BME280_PRESS_Q_DIV;
+	*t_err = fabs((double)data.temp - ((double)q.temp / BME280_TEMP_Q_DIV));
+	*p_err = ( (p < 300.0) || (p > 1100.0) ) ? -1.0 : fabs((double)data.press - p);
+	*h_err = fabs((double)data.hum - ((double)q.hum / (double)(1UL << BME280_HUM_Q_SHIFT)));
+
+	return BME280_OK;
+}
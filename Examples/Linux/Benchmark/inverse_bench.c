@@ -0,0 +1,259 @@
+/**
+  ******************************************************************************
+  * File Name          : inverse_bench.c
+  * Description        : Throughput and round trip check of inverse compensation
+  ******************************************************************************
+  *
+  * Program synthesizes adc frames with BME280_InverseFrame on simulated
+  * sensor (mock_bus.h) for two sets of TARGETS_NR targets:
+  * - slow trace, adc values change by few counts between targets (random
+  *   walk), like in trace of real sensor, so secant steps start close,
+  * - random targets, adc values uniform over -40..85 degC, 300..1100 hPa and
+  *   full humidity range, so every search starts far from the target.
+  * Targets are compensated from adc values before. Frames per second (best
+  * of RUNS_NR runs) are printed, then every frame is written to adc
+  * registers, read back with BME280_ReadAllLast_Q and compared with its
+  * target: temperature must be the same, pressure and humidity the nearest
+  * ones at t_fine of found adc_T (several adc_T give the same temperature
+  * with other t_fine, so target itself can be out of reach). With USE_STATS program
+  * checks that compensations of search are not counted by BME280_GetStats:
+  * gcc -O2 -DUSE_INVERSE -I../../.. inverse_bench.c ../../../bme280.c -o inverse
+  * gcc -O2 -DUSE_INVERSE -DUSE_STATS -I../../.. inverse_bench.c ../../../bme280.c -o inverse_stats
+  * Program returns 1 if any frame gives other results than its target (or
+  * if compensations of search are counted).
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if !defined(USE_INVERSE) || !defined(USE_FIXED_RESULTS) || !defined(USE_NORMAL_MODE)
+#error "USE_INVERSE, USE_FIXED_RESULTS and USE_NORMAL_MODE must be set"
+#endif
+
+/* public defines */
+#define TARGETS_NR		(1UL << 20)
+#define RUNS_NR			(5U)
+#define ADC_P_LO		(0x40000L)	// adc_P range of 300..1100 hPa
+#define ADC_P_HI		(0xE0000L)
+#define WALK_T			(8)			// max. step of slow trace, +- counts
+#define WALK_P			(32)
+#define WALK_H			(8)
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+BME280_DataQ_t targets[TARGETS_NR];
+uint8_t frames[TARGETS_NR][8];
+int32_t adc_t_lo, adc_t_hi;
+
+/* function prototypes */
+int32_t rand_range(int32_t lo, int32_t hi);
+int32_t walk(int32_t adc, int32_t step, int32_t lo, int32_t hi);
+void make_targets(uint8_t slow);
+double bench(void);
+uint32_t dist(BME280_U32_t a, BME280_U32_t b);
+uint8_t nearest(uint8_t press, BME280_S32_t adc, BME280_U32_t value, BME280_U32_t target);
+uint32_t round_trip(uint32_t *exact);
+int32_t find_adc_t(int32_t temp);
+
+
+	/* main */
+int main(void){
+
+	const char *names[2] = { "slow trace", "random targets" };
+	double rate, rate_max;
+	uint32_t errors, exact, all = 0;
+	uint8_t i, j;
+#ifdef USE_STATS
+	BME280_Stats_t before, after;
+#endif
+
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+	mock_power_on();
+
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.mode = BME280_NORMALMODE;
+
+	if( (BME280_OK != BME280_Init(&bme, &bme_driver)) ||
+			(BME280_OK != BME280_ConfigureAll(&bme, &bme_config)) ){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	adc_t_lo = find_adc_t(-4000);
+	adc_t_hi = find_adc_t(8500);
+	srand(1);
+
+	printf("BME280_InverseFrame, %lu targets (best of %u runs):\n", TARGETS_NR, RUNS_NR);
+	for(i = 0; i < 2; i++){
+
+		make_targets(1 - i);
+
+		rate_max = 0.0;
+#ifdef USE_STATS
+		BME280_GetStats(&bme, &before);
+#endif
+		for(j = 0; j < RUNS_NR; j++){
+
+			rate = bench();
+			if(rate > rate_max) rate_max = rate;
+		}
+#ifdef USE_STATS
+		/* compensations of search must not be counted */
+		BME280_GetStats(&bme, &after);
+		if( (before.comp_temp != after.comp_temp) || (before.comp_press != after.comp_press) ||
+				(before.comp_hum != after.comp_hum) ){
+
+			printf("  %s: compensations of search counted by BME280_GetStats\n", names[i]);
+			all++;
+		}
+#endif
+
+		errors = round_trip(&exact);
+		all += errors;
+		printf("  %-16s %8.2f M frames/s, round trip errors: %u (exact: %u)\n", names[i], rate_max / 1e6, errors,
+				exact);
+	}
+
+	return (0 == all) ? 0 : 1;
+}
+
+
+	/* function returns random value of lo..hi range */
+int32_t rand_range(int32_t lo, int32_t hi){
+
+	return lo + (int32_t)((uint32_t)rand() % (uint32_t)(hi - lo + 1));
+}
+
+	/* function moves adc value by random step inside lo..hi range */
+int32_t walk(int32_t adc, int32_t step, int32_t lo, int32_t hi){
+
+	adc += rand_range(-step, step);
+	if(adc < lo) adc = lo;
+	if(adc > hi) adc = hi;
+
+	return adc;
+}
+
+	/* function fills table of targets compensated from adc values */
+void make_targets(uint8_t slow){
+
+	int32_t adc_T = MOCK_ADC_T, adc_P = MOCK_ADC_P, adc_H = MOCK_ADC_H;
+	uint32_t i;
+
+	for(i = 0; i < TARGETS_NR; i++){
+
+		if(slow){
+
+			adc_T = walk(adc_T, WALK_T, adc_t_lo, adc_t_hi);
+			adc_P = walk(adc_P, WALK_P, ADC_P_LO, ADC_P_HI);
+			adc_H = walk(adc_H, WALK_H, 0, 0xFFFF);
+		}
+		else{
+
+			adc_T = rand_range(adc_t_lo, adc_t_hi);
+			adc_P = rand_range(ADC_P_LO, ADC_P_HI);
+			adc_H = rand_range(0, 0xFFFF);
+		}
+
+		BME280_CompensateTemp(&bme, adc_T, &targets[i].temp);
+		BME280_CompensatePress(&bme, adc_P, &targets[i].press);
+		BME280_CompensateHum(&bme, adc_H, &targets[i].hum);
+	}
+}
+
+	/* function returns frames synthesized per second */
+double bench(void){
+
+	uint64_t begin;
+	uint32_t i;
+
+	begin = mock_now_ns();
+	for(i = 0; i < TARGETS_NR; i++) BME280_InverseFrame(&bme, &targets[i], frames[i]);
+
+	return (double)TARGETS_NR * 1e9 / (double)(mock_now_ns() - begin);
+}
+
+	/* function returns distance between values */
+uint32_t dist(BME280_U32_t a, BME280_U32_t b){
+
+	return (a > b) ? (a - b) : (b - a);
+}
+
+	/* function returns 1 if "adc" gives value of channel nearest to target (at current t_fine) */
+uint8_t nearest(uint8_t press, BME280_S32_t adc, BME280_U32_t value, BME280_U32_t target){
+
+	BME280_U32_t lo = 0, hi = 0;
+
+	if(press){
+
+		BME280_CompensatePress(&bme, adc - 1, &lo);
+		BME280_CompensatePress(&bme, adc + 1, &hi);
+	}
+	else{
+
+		BME280_CompensateHum(&bme, adc - 1, &lo);
+		BME280_CompensateHum(&bme, adc + 1, &hi);
+	}
+
+	return ( (dist(value, target) <= dist(lo, target)) && (dist(value, target) <= dist(hi, target)) ) ? 1 : 0;
+}
+
+	/* function reads every frame back and returns number of frames with other results than target */
+uint32_t round_trip(uint32_t *exact){
+
+	BME280_DataQ_t data;
+	BME280_S32_t adc_P, adc_H;
+	uint32_t i, errors = 0;
+
+	*exact = 0;
+	for(i = 0; i < TARGETS_NR; i++){
+
+		memcpy(&mock_regs[BME280_PRESS_ADC_ADDR], frames[i], sizeof(frames[i]));
+		adc_P = ((BME280_S32_t)frames[i][0] << 12) | ((BME280_S32_t)frames[i][1] << 4) | (frames[i][2] >> 4);
+		adc_H = ((BME280_S32_t)frames[i][6] << 8) | frames[i][7];
+
+		/* temperature must be the same, pressure and humidity the nearest ones at t_fine of found adc_T */
+		if( (BME280_OK != BME280_ReadAllLast_Q(&bme, &data)) || (data.temp != targets[i].temp) ||
+				(0 == nearest(1, adc_P, data.press, targets[i].press)) ||
+				(0 == nearest(0, adc_H, data.hum, targets[i].hum)) ){
+
+			if(0 == errors){
+
+				printf("  target %u: %d, %u, %u, read back: %d, %u, %u\n", i, targets[i].temp, targets[i].press,
+						targets[i].hum, data.temp, data.press, data.hum);
+			}
+			errors++;
+		}
+		else if( (data.press == targets[i].press) && (data.hum == targets[i].hum) ) (*exact)++;
+	}
+
+	return errors;
+}
+
+	/* function returns first adc_T with temperature not lower than "temp" */
+int32_t find_adc_t(int32_t temp){
+
+	BME280_S32_t adc_T, t;
+
+	for(adc_T = 0; adc_T < 0xFFFFF; adc_T++){
+
+		BME280_CompensateTemp(&bme, adc_T, &t);
+		if(t >= temp) break;
+	}
+
+	return adc_T;
+}
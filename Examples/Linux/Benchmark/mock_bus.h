@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * File Name          : mock_bus.h
+  * Description        : Simulated BME280 registers for benchmarks
+  ******************************************************************************
+  *
+  * Registers of single sensor are kept in RAM, so benchmarks and checks in
+  * this directory run without hardware. Calibration data are the example
+  * values of datasheet (temperature and pressure) and typical humidity
+  * values. Sensor is never busy and returns to sleep mode after forced
+  * measurement, adc registers are set with mock_set_adc.
+  * Include this file in single source file only.
+  *
+  ******************************************************************************
+  */
+
+#ifndef MOCK_BUS_H
+#define MOCK_BUS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "bme280.h"
+
+/* public defines */
+#define MOCK_ADC_T		(519888L)	///< adc_T of datasheet example (25.08 degC)
+#define MOCK_ADC_P		(415148L)	///< adc_P of datasheet example (1006.5 hPa)
+#define MOCK_ADC_H		(30000L)	///< adc_H giving about 56 %RH
+
+/* public variables */
+static uint8_t mock_regs[256];
+
+
+	/* function stores 16-bit little endian value */
+static inline void mock_put16(uint8_t reg_addr, int32_t value){
+
+	mock_regs[reg_addr] = (uint8_t)(value & 0xFF);
+	mock_regs[reg_addr + 1] = (uint8_t)((value >> 8) & 0xFF);
+}
+
+	/* function sets raw values returned by sensor */
+static inline void mock_set_adc(int32_t adc_P, int32_t adc_T, int32_t adc_H){
+
+	mock_regs[0xF7] = (uint8_t)(adc_P >> 12);
+	mock_regs[0xF8] = (uint8_t)(adc_P >> 4);
+	mock_regs[0xF9] = (uint8_t)((adc_P << 4) & 0xF0);
+	mock_regs[0xFA] = (uint8_t)(adc_T >> 12);
+	mock_regs[0xFB] = (uint8_t)(adc_T >> 4);
+	mock_regs[0xFC] = (uint8_t)((adc_T << 4) & 0xF0);
+	mock_regs[0xFD] = (uint8_t)(adc_H >> 8);
+	mock_regs[0xFE] = (uint8_t)(adc_H & 0xFF);
+}
+
+	/* function fills registers after power on */
+static inline void mock_power_on(void){
+
+	int16_t h4 = 313, h5 = 50;
+
+	memset(mock_regs, 0, sizeof(mock_regs));
+	mock_regs[BME280_ID_ADDR] = BME280_ID;
+
+	/* dig_T1..dig_T3, dig_P1..dig_P9 */
+	mock_put16(0x88, 27504);
+	mock_put16(0x8A, 26435);
+	mock_put16(0x8C, -1000);
+	mock_put16(0x8E, 36477);
+	mock_put16(0x90, -10685);
+	mock_put16(0x92, 3024);
+	mock_put16(0x94, 2855);
+	mock_put16(0x96, 140);
+	mock_put16(0x98, -7);
+	mock_put16(0x9A, 15500);
+	mock_put16(0x9C, -14600);
+	mock_put16(0x9E, 6000);
+
+	/* dig_H1..dig_H6 */
+	mock_regs[0xA1] = 75;
+	mock_put16(0xE1, 362);
+	mock_regs[0xE3] = 0;
+	mock_regs[0xE4] = (uint8_t)(h4 >> 4);
+	mock_regs[0xE5] = (uint8_t)((h4 & 0x0F) | ((h5 & 0x0F) << 4));
+	mock_regs[0xE6] = (uint8_t)(h5 >> 4);
+	mock_regs[0xE7] = 30;
+
+	mock_set_adc(MOCK_ADC_P, MOCK_ADC_T, MOCK_ADC_H);
+}
+
+	/* function reads registers */
+static inline int8_t mock_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	(void)driver;
+	memcpy(rxbuff, &mock_regs[reg_addr], rxlen);
+
+	return 0;
+}
+
+	/* function writes register, reset is ignored and forced mode ends at once */
+static inline int8_t mock_write(uint8_t reg_addr, uint8_t value, void *driver){
+
+	(void)driver;
+	if(BME280_RESET_ADDR == reg_addr) return 0;
+
+	if( (BME280_CTRL_MEAS_ADDR == reg_addr) && (BME280_NORMALMODE != (value & 0x03)) ) value &= 0xFC;
+	mock_regs[reg_addr] = value;
+
+	return 0;
+}
+
+	/* function doesn't wait */
+static inline void mock_delay(uint8_t delay_time){
+
+	(void)delay_time;
+}
+
+	/* function returns monotonic time in ns */
+static inline uint64_t mock_now_ns(void){
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#endif /* MOCK_BUS_H */
@@ -0,0 +1,202 @@
+/**
+  ******************************************************************************
+  * File Name          : press_lut_check.c
+  * Description        : Accuracy and throughput check of pressure lookup table
+  ******************************************************************************
+  *
+  * Program checks pressure compensation with lookup table (USE_PRESS_LUT) on
+  * simulated sensor (mock_bus.h):
+  * - accuracy sweep, BME280_CompensatePress is compared with 64-bit formula
+  *   of datasheet (reference) over -40..85 degC and 300..1100 hPa, adc_T is
+  *   swept up and down, so the table is used at every position of its
+  *   t_fine window,
+  * - noisy samples, BME280_ReadAllLast_Q reads SAMPLES_NR samples with adc_T
+  *   noise of +-T_NOISE counts and adc_P noise of +-P_NOISE counts, number
+  *   of full pressure compensations per sample is taken from BME280_GetStats
+  *   and time per sample is measured.
+  * Build it with and without the table and compare results, knot distance
+  * can be changed with -DBME280_PRESS_LUT_SHIFT=x (and -DBME280_PRESS_LUT_TSHIFT=x):
+  * gcc -O2 -DUSE_STATS -DUSE_PRESS_LUT -I../../.. press_lut_check.c ../../../bme280.c -o lut
+  * gcc -O2 -DUSE_STATS -I../../.. press_lut_check.c ../../../bme280.c -o full
+  * Program returns 1 if error is above P_BOUND (Pa).
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if !defined(USE_FIXED_RESULTS) || !defined(USE_NORMAL_MODE) || !defined(USE_STATS)
+#error "USE_FIXED_RESULTS, USE_NORMAL_MODE and USE_STATS must be set"
+#endif
+
+/* public defines */
+#define SAMPLES_NR		(1000000UL)
+#define RUNS_NR			(7U)
+#define T_NOISE			(2)			// adc_T noise, +- counts
+#define P_NOISE			(16)		// adc_P noise, +- counts
+#define T_STEP			(7L)		// adc_T step of sweep (about 0.002 degC)
+#define P_STEP			(509L)		// adc_P step of sweep
+#define NOISE_NR		(4096U)		// length of noise tables, power of two
+#ifndef P_BOUND
+#ifdef USE_64BIT
+#define P_BOUND			(2.0)		// Pa
+#else
+#define P_BOUND			(10.0)		// Pa, 32-bit formula itself differs from 64-bit one by up to 6.8 Pa
+#endif
+#endif
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+int8_t noise_t[NOISE_NR], noise_p[NOISE_NR];
+
+/* function prototypes */
+double reference_pa(BME280_t *Dev, BME280_S32_t adc_P);
+double sweep(int8_t dir, uint32_t *points);
+double bench(double *comp);
+
+
+	/* main */
+int main(void){
+
+	double err, err_max, t, t_min = 1e9, comp = 0.0;
+	uint32_t points, all = 0;
+	uint8_t i;
+
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+	mock_power_on();
+
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.mode = BME280_NORMALMODE;
+
+	if( (BME280_OK != BME280_Init(&bme, &bme_driver)) ||
+			(BME280_OK != BME280_ConfigureAll(&bme, &bme_config)) ){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	/* accuracy, adc_T up and down */
+	err_max = sweep(1, &points);
+	all += points;
+	err = sweep(-1, &points);
+	all += points;
+	if(err > err_max) err_max = err;
+
+	/* noisy samples, noise is generated before to keep rand() out of measurement */
+	srand(1);
+	for(points = 0; points < NOISE_NR; points++){
+
+		noise_t[points] = (int8_t)((rand() % (2 * T_NOISE + 1)) - T_NOISE);
+		noise_p[points] = (int8_t)((rand() % (2 * P_NOISE + 1)) - P_NOISE);
+	}
+
+	/* best of RUNS_NR runs */
+	for(i = 0; i < RUNS_NR; i++){
+
+		t = bench(&comp);
+		if(t < t_min) t_min = t;
+	}
+
+#ifdef USE_PRESS_LUT
+	printf("lookup table, shift %u (%u knots), t_fine window %u:\n", BME280_PRESS_LUT_SHIFT,
+			(unsigned)BME280_PRESS_LUT_KNOTS, 1U << BME280_PRESS_LUT_TSHIFT);
+#else
+	printf("full formula:\n");
+#endif
+	printf("  max. error            %.3f Pa (%u points), bound %.1f\n", err_max, all, P_BOUND);
+	printf("  full compensations    %.3f per sample (adc_T +-%d, adc_P +-%d)\n", comp, T_NOISE, P_NOISE);
+	printf("  BME280_ReadAllLast_Q  %.1f ns per sample (best of %u runs)\n", t_min, RUNS_NR);
+
+	return (err_max > P_BOUND) ? 1 : 0;
+}
+
+
+	/* function returns pressure in Pa calculated with 64-bit formula of datasheet for t_fine of *Dev */
+double reference_pa(BME280_t *Dev, BME280_S32_t adc_P){
+
+	int64_t var1, var2, p;
+
+	var1 = ((int64_t)Dev->t_fine) - 128000;
+	var2 = var1 * var1 * (int64_t)Dev->trimm.dig_P6;
+	var2 = var2 + ((var1 * (int64_t)Dev->trimm.dig_P5) * 131072);
+	var2 = var2 + (((int64_t)Dev->trimm.dig_P4) * 34359738368);
+	var1 = ((var1 * var1 * (int64_t)Dev->trimm.dig_P3) / 256) + ((var1 * (int64_t)Dev->trimm.dig_P2) * 4096);
+	var1 = (((int64_t)1) * 140737488355328 + var1) * ((int64_t)Dev->trimm.dig_P1) / 8589934592;
+	if(0 == var1) return 0.0;
+
+	p = 1048576 - adc_P;
+	p = (((p * 2147483648) - var2) * 3125) / var1;
+	var1 = (((int64_t)Dev->trimm.dig_P9) * (p / 8192) * (p / 8192)) / 33554432;
+	var2 = (((int64_t)Dev->trimm.dig_P8) * p) / 524288;
+	p = ((p + var1 + var2) / 256) + (((int64_t)Dev->trimm.dig_P7) * 16);
+
+	/* Q24.8 Pa */
+	return (double)p / 256.0;
+}
+
+	/* function returns max. error of BME280_CompensatePress in Pa, adc_T goes up (dir = 1) or down */
+double sweep(int8_t dir, uint32_t *points){
+
+	BME280_S32_t adc_T, adc_P, temp;
+	BME280_U32_t press;
+	double ref, p, err, err_max = 0.0;
+
+	*points = 0;
+	for(adc_T = (dir > 0) ? 0 : 0xFFFFF; (adc_T >= 0) && (adc_T <= 0xFFFFF); adc_T += dir * T_STEP){
+
+		BME280_CompensateTemp(&bme, adc_T, &temp);
+		if( (temp < -4000) || (temp > 8500) ) continue;
+
+		for(adc_P = 0x30000L; adc_P < 0xF0000L; adc_P += P_STEP){
+
+			ref = reference_pa(&bme, adc_P);
+			if( (ref < 30000.0) || (ref > 110000.0) ) continue;
+
+			BME280_CompensatePress(&bme, adc_P, &press);
+			/* BME280_PRESS_Q_DIV counts per hPa */
+			p = (double)press * 100.0 / (double)BME280_PRESS_Q_DIV;
+			err = (p > ref) ? (p - ref) : (ref - p);
+			if(err > err_max) err_max = err;
+			(*points)++;
+		}
+	}
+
+	return err_max;
+}
+
+	/* function returns ns per noisy sample and number of full pressure compensations per sample */
+double bench(double *comp){
+
+	BME280_DataQ_t data;
+	BME280_Stats_t stats;
+	uint64_t begin;
+	uint32_t i, sum = 0;
+
+	BME280_ResetStats(&bme);
+
+	begin = mock_now_ns();
+	for(i = 0; i < SAMPLES_NR; i++){
+
+		mock_set_adc(MOCK_ADC_P + noise_p[i % NOISE_NR], MOCK_ADC_T + noise_t[i % NOISE_NR], MOCK_ADC_H);
+		BME280_ReadAllLast_Q(&bme, &data);
+		sum += data.press;
+	}
+
+	if(1 == sum) printf(" ");
+	BME280_GetStats(&bme, &stats);
+	*comp = (double)stats.comp_press / (double)stats.samples;
+
+	return (double)(mock_now_ns() - begin) / SAMPLES_NR;
+}
@@ -0,0 +1,135 @@
+/**
+  ******************************************************************************
+  * File Name          : static_bus_bench.c
+  * Description        : Benchmark of static bus binding
+  ******************************************************************************
+  *
+  * Program measures time per read of BME280_ReadAllLast_Q (normal mode) and
+  * BME280_ReadAllForce_Q (forced mode) on simulated sensor (mock_bus.h). Build
+  * it twice, with bus functions passed as pointers in BME280_Driver_t and with
+  * USE_STATIC_BUS, and compare results. Link time optimization lets compiler
+  * inline bme280_static_xxx functions into the driver:
+  * gcc -O2 -flto -I../../.. static_bus_bench.c ../../../bme280.c -o bench_ptr
+  * gcc -O2 -flto -DUSE_STATIC_BUS -I../../.. static_bus_bench.c ../../../bme280.c -o bench_static
+  * Code size of the driver is compared with:
+  * gcc -Os -c -I../../.. ../../../bme280.c && size bme280.o
+  * gcc -Os -c -DUSE_STATIC_BUS -I../../.. ../../../bme280.c && size bme280.o
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "bme280.h"
+#include "mock_bus.h"
+
+#if !defined(USE_FIXED_RESULTS) || !defined(USE_NORMAL_MODE) || !defined(USE_FORCED_MODE)
+#error "USE_FIXED_RESULTS, USE_NORMAL_MODE and USE_FORCED_MODE must be set in bme280.h"
+#endif
+
+#ifdef USE_STATIC_BUS
+#include "bme280_bus.h"
+#endif
+
+/* public defines */
+#define SAMPLES_NR		(1000000UL)
+#define RUNS_NR			(7U)
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+/* function prototypes */
+double bench(uint8_t forced);
+
+
+	/* main */
+int main(void){
+
+	double t_last = 1e9, t_force = 1e9, t;
+	uint8_t i;
+
+#ifndef USE_STATIC_BUS
+	bme_driver.read = mock_read;
+	bme_driver.write = mock_write;
+	bme_driver.delay = mock_delay;
+#endif
+	mock_power_on();
+
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.mode = BME280_SLEEPMODE;
+
+	if( (BME280_OK != BME280_Init(&bme, &bme_driver)) ||
+			(BME280_OK != BME280_ConfigureAll(&bme, &bme_config)) ){
+
+		printf("init failed\n");
+		return 1;
+	}
+
+	/* forced mode first, then normal mode, best of RUNS_NR runs */
+	for(i = 0; i < RUNS_NR; i++){
+
+		t = bench(1);
+		if(t < t_force) t_force = t;
+	}
+
+	if(BME280_OK != BME280_SetMode(&bme, BME280_NORMALMODE)) return 1;
+	for(i = 0; i < RUNS_NR; i++){
+
+		t = bench(0);
+		if(t < t_last) t_last = t;
+	}
+
+#ifdef USE_STATIC_BUS
+	printf("static bus, ns per read (best of %u runs):\n", RUNS_NR);
+#else
+	printf("bus pointers, ns per read (best of %u runs):\n", RUNS_NR);
+#endif
+	printf("  BME280_ReadAllForce_Q  %6.1f\n", t_force);
+	printf("  BME280_ReadAllLast_Q   %6.1f\n", t_last);
+
+	return 0;
+}
+
+
+	/* function returns ns per read */
+double bench(uint8_t forced){
+
+	BME280_DataQ_t data;
+	uint64_t begin;
+	uint32_t i, sum = 0;
+
+	begin = mock_now_ns();
+	for(i = 0; i < SAMPLES_NR; i++){
+
+		mock_set_adc(MOCK_ADC_P + (i & 0x3FF), MOCK_ADC_T + (i & 0xFF), MOCK_ADC_H + (i & 0x7F));
+		if(forced) BME280_ReadAllForce_Q(&bme, &data);
+		else BME280_ReadAllLast_Q(&bme, &data);
+		sum += data.press + (uint32_t)data.temp + data.hum;
+	}
+
+	if(1 == sum) printf(" ");
+	return (double)(mock_now_ns() - begin) / SAMPLES_NR;
+}
+
+#ifdef USE_STATIC_BUS
+	/* bus functions bound at compile time */
+int8_t bme280_static_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	return mock_read(reg_addr, rxbuff, rxlen, driver);
+}
+
+int8_t bme280_static_write(uint8_t reg_addr, uint8_t value, void *driver){
+
+	return mock_write(reg_addr, value, driver);
+}
+
+void bme280_static_delay(uint8_t delay_time){
+
+	mock_delay(delay_time);
+}
+#endif
@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * File Name          : main.c
+  * Description        : Capacity planning example for Linux
+  ******************************************************************************
+  *
+  * This is an example of use BME280 capacity planner, no hardware is needed.
+  * Program reads description of buses from file (or stdin if no file given),
+  * one bus per line, fields separated with spaces, '#' starts comment:
+  *
+  * name bus clock_hz overhead_ns sensors mode ovs_t ovs_p ovs_h t_stby_ms batched rate_hz vdd_mv [channels]
+  *
+  * bus - "i2c" or "spi", mode - "forced" or "normal", ovs_x - oversampling
+  * (0 - skipped, 1, 2, 4, 8, 16), t_stby_ms - standby time of normal mode
+  * (0.5, 10, 20, 62.5, 125, 250, 500 or 1000), batched - 1 if fleet layer is
+  * used, rate_hz - target rate of every sensor (0 - as fast as possible),
+  * channels - number of multiplexer channels (optional, 0 - no multiplexer),
+  * f.e.
+  *
+  * hvac   i2c 100000  20000 8  forced 1 1 1 0.5 1 1   3300 4
+  * floor1 i2c 400000  20000 32 forced 1 4 1 0.5 0 5   3300 16
+  * lab    spi 8000000 5000  4  normal 2 16 1 0.5 0 100 1800
+  *
+  * Bus utilization, achievable rate, worst-case skew and energy per sample are
+  * printed for every bus, oversubscribed buses are marked and program returns 2.
+  * Build: gcc -O2 -I../../.. main.c ../../../bme280_plan.c ../../../bme280_record.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bme280.h"
+#include "bme280_plan.h"
+
+/* public defines */
+#define BUSES_NR		(64U)
+#define NAME_LEN		(16U)
+#define LINE_LEN		(256U)
+
+/* public variables */
+BME280_PlanBus_t buses[BUSES_NR];
+BME280_Plan_t plans[BUSES_NR];
+char names[BUSES_NR][NAME_LEN];
+
+/* function prototypes */
+int parse_line(const char *line, BME280_PlanBus_t *bus, char *name);
+int ovs_to_osrs(unsigned ovs, uint8_t *osrs);
+int stby_to_tstby(double stby, uint8_t *t_stby);
+
+
+	/* main */
+int main(int argc, char **argv){
+
+	FILE *f = stdin;
+	char line[LINE_LEN];
+	unsigned i, n = 0, line_nr = 0;
+	uint8_t over;
+	int res;
+
+	if(argc > 1){
+
+		f = fopen(argv[1], "r");
+		if(NULL == f){
+
+			perror(argv[1]);
+			return 1;
+		}
+	}
+
+	while( (n < BUSES_NR) && (NULL != fgets(line, sizeof(line), f)) ){
+
+		line_nr++;
+		res = parse_line(line, &buses[n], names[n]);
+		if(res < 0){
+
+			printf("line %u: wrong description\n", line_nr);
+			return 1;
+		}
+		if(res > 0) n++;
+	}
+	if(stdin != f) fclose(f);
+
+	if(BME280_PlanFleet(buses, (uint8_t)n, plans, &over) != BME280_OK){
+
+		printf("wrong parameters of bus\n");
+		return 1;
+	}
+
+	printf("%-16s %8s %8s %12s %12s %8s %10s %10s\n", "bus", "sensors", "util %", "rate Hz", "target Hz",
+			"skew ms", "pass ms", "uJ/sample");
+	for(i = 0; i < n; i++){
+
+		printf("%-16s %8u %8.2f %12.3f %12.3f %8.2f %10.2f %10.2f%s\n", names[i], buses[i].sensors,
+				plans[i].utilization / 100.0, plans[i].rate_mhz / 1000.0, buses[i].rate_mhz / 1000.0,
+				plans[i].skew_us / 1000.0, plans[i].period_us / 1000.0, plans[i].energy_nj / 1000.0,
+				plans[i].oversubscribed ? "  OVERSUBSCRIBED" : "");
+	}
+
+	return (0 == over) ? 0 : 2;
+}
+
+
+/* functions definitions */
+int parse_line(const char *line, BME280_PlanBus_t *bus, char *name){
+
+	char type[8], mode[8];
+	unsigned long clock, overhead, vdd;
+	unsigned sensors, ovs_t, ovs_p, ovs_h, batched, channels = 0;
+	int fields;
+	double stby, rate;
+
+	/* skip empty lines and comments */
+	line += strspn(line, " \t\r\n");
+	if( ('\0' == *line) || ('#' == *line) ) return 0;
+
+	fields = sscanf(line, "%15s %7s %lu %lu %u %7s %u %u %u %lf %u %lf %lu %u", name, type, &clock, &overhead,
+			&sensors, mode, &ovs_t, &ovs_p, &ovs_h, &stby, &batched, &rate, &vdd, &channels);
+	if( (13 != fields) && (14 != fields) ) return -1;
+
+	memset(bus, 0, sizeof(BME280_PlanBus_t));
+
+	if(0 == strcmp(type, "i2c")) bus->bus.type = BME280_BUS_I2C;
+	else if(0 == strcmp(type, "spi")) bus->bus.type = BME280_BUS_SPI;
+	else return -1;
+
+	if(0 == strcmp(mode, "forced")) bus->mode = BME280_FORCEDMODE;
+	else if(0 == strcmp(mode, "normal")) bus->mode = BME280_NORMALMODE;
+	else return -1;
+
+	if( (0 != ovs_to_osrs(ovs_t, &bus->osrs_t)) || (0 != ovs_to_osrs(ovs_p, &bus->osrs_p)) ||
+			(0 != ovs_to_osrs(ovs_h, &bus->osrs_h)) || (0 != stby_to_tstby(stby, &bus->t_stby)) ) return -1;
+	if( (0 == sensors) || (sensors > 255U) || (channels > sensors) || (rate < 0.0) || (rate > 4000000.0) ||
+			(vdd > 65535UL) ) return -1;
+
+	bus->bus.clock_hz = (uint32_t)clock;
+	bus->bus.overhead_ns = (uint32_t)overhead;
+	bus->sensors = (uint8_t)sensors;
+	bus->batched = (0 != batched) ? 1 : 0;
+	bus->channels = (uint8_t)channels;
+	bus->rate_mhz = (uint32_t)(rate * 1000.0 + 0.5);
+	bus->vdd_mv = (uint16_t)vdd;
+
+	return 1;
+}
+
+int ovs_to_osrs(unsigned ovs, uint8_t *osrs){
+
+	switch(ovs){
+
+	case 0: *osrs = BME280_OVERSAMPLING_SKIPP; break;
+	case 1: *osrs = BME280_OVERSAMPLING_X1; break;
+	case 2: *osrs = BME280_OVERSAMPLING_X2; break;
+	case 4: *osrs = BME280_OVERSAMPLING_X4; break;
+	case 8: *osrs = BME280_OVERSAMPLING_X8; break;
+	case 16: *osrs = BME280_OVERSAMPLING_X16; break;
+	default: return -1;
+	}
+
+	return 0;
+}
+
+int stby_to_tstby(double stby, uint8_t *t_stby){
+
+	static const double values[8] = { 0.5, 62.5, 125.0, 250.0, 500.0, 1000.0, 10.0, 20.0 };
+	uint8_t i;
+
+	for(i = 0; i < 8; i++){
+
+		if(stby == values[i]){
+
+			*t_stby = i;
+			return 0;
+		}
+	}
+
+	return -1;
+}
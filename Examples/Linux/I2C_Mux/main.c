@@ -0,0 +1,277 @@
+/**
+  ******************************************************************************
+  * File Name          : main.c
+  * Description        : Fleet read example for Linux i2c-dev with I2C multiplexer
+  ******************************************************************************
+  *
+  * This is an example of use BME280_driver with Linux, i2c-dev interface and
+  * TCA9548A I2C multiplexer at address 0x70. Two sensors (0x76 and 0x77) are
+  * connected to every used channel of multiplexer. Each sensor is initialized
+  * and configured to work in sleep mode with its own BME280_t and
+  * BME280_Driver_t structures. Every second fleet layer forces measurement of
+  * all sensors channel by channel, waits once and reads them back in reverse
+  * channel order, so every channel is selected at most twice per cycle.
+  * Build: gcc -O2 -I../../.. main.c ../../../bme280.c ../../../bme280_fleet.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "bme280.h"
+#include "bme280_fleet.h"
+
+/* public defines */
+#define I2C_DEVICE		"/dev/i2c-1"
+#define MUX_ADDRESS		(0x70)
+#define CHANNELS_NR		(3U)
+#define SENSORS_NR		(2U * CHANNELS_NR)
+
+/* public variables */
+static const uint8_t bme_addresses[SENSORS_NR] = { BME280_I2CADDR_SDOL, BME280_I2CADDR_SDOH,
+		BME280_I2CADDR_SDOL, BME280_I2CADDR_SDOH, BME280_I2CADDR_SDOL, BME280_I2CADDR_SDOH };
+static const uint8_t bme_channels[SENSORS_NR] = { 0, 0, 1, 1, 2, 2 };
+
+BME280_t bme[SENSORS_NR];
+BME280_t *bme_ptrs[SENSORS_NR];
+BME280_Driver_t bme_driver[SENSORS_NR];
+BME280_Config_t bme_config;
+BME280_DataQ_t bme_data[SENSORS_NR];
+int8_t bme_results[SENSORS_NR];
+
+BME280_FleetRead_t fleet_reads[SENSORS_NR];
+BME280_Fleet_t fleet;
+
+int i2c_fd;
+
+/* function prototypes */
+int bme_init(void);
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver);
+void bme280_delay_platform_spec(uint8_t delay_time);
+int8_t bme280_fleetread_platform_spec(BME280_FleetRead_t *reads, uint8_t count, void *fleet);
+int8_t bme280_select_platform_spec(uint8_t channel, void *fleet);
+
+
+	/* main */
+int main(void){
+
+	struct timespec period = { 1, 0 };
+	uint8_t i;
+
+	i2c_fd = open(I2C_DEVICE, O_RDWR);
+	if(i2c_fd < 0){
+
+		perror(I2C_DEVICE);
+		return 1;
+	}
+
+	if(0 != bme_init()) return 1;
+
+	for(;;){
+
+		nanosleep(&period, NULL);
+
+		/* measure and read all sensors */
+		fleet.selects = 0;
+		BME280_FleetReadAllForce(&fleet, bme_data, bme_results);
+
+		for(i = 0; i < SENSORS_NR; i++){
+
+			if(BME280_OK == bme_results[i]){
+
+				printf("BME280 %u/0x%02X: %.2f degC, %.4f hPa, %.3f %%RH\n", bme_channels[i], bme_addresses[i],
+						bme_data[i].temp / (double)BME280_TEMP_Q_DIV, bme_data[i].press / (double)BME280_PRESS_Q_DIV,
+						bme_data[i].hum / (double)(1UL << BME280_HUM_Q_SHIFT));
+			}
+			else{
+
+				printf("BME280 %u/0x%02X: error!, res = %d\n", bme_channels[i], bme_addresses[i], bme_results[i]);
+			}
+		}
+
+		printf("channel selects: %u\n", (unsigned)fleet.selects);
+	}
+}
+
+
+/* functions definitions */
+int bme_init(void){
+
+	uint8_t i;
+
+	/* sensor's options */
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.filter = BME280_FILTER_OFF;
+	bme_config.t_stby = BME280_STBY_1000MS;
+	bme_config.spi3w_enable = 0;
+	bme_config.mode = BME280_SLEEPMODE;
+
+	/* setup fleet first, its select function is used during initialization */
+	fleet.devs = bme_ptrs;
+	fleet.reads = fleet_reads;
+	fleet.count = SENSORS_NR;
+	fleet.read = bme280_fleetread_platform_spec;
+	fleet.env_spec_data = &i2c_fd;
+	fleet.channels = bme_channels;
+	fleet.select = bme280_select_platform_spec;
+	fleet.channel = BME280_FLEET_NO_CHANNEL;
+	fleet.delay = bme280_delay_platform_spec;
+
+	for(i = 0; i < SENSORS_NR; i++){
+
+		/* setup driver of every sensor */
+		bme_driver[i].read = bme280_read_platform_spec;
+		bme_driver[i].write = bme280_write_platform_spec;
+		bme_driver[i].delay = bme280_delay_platform_spec;
+		bme_driver[i].env_spec_data = &i2c_fd;
+		bme_driver[i].i2c_address = bme_addresses[i];
+
+		/* connect sensor to the bus */
+		if( (bme_channels[i] != fleet.channel) && (0 != bme280_select_platform_spec(bme_channels[i], &fleet)) ){
+
+			printf("TCA9548A: select error\n");
+			return -1;
+		}
+		fleet.channel = bme_channels[i];
+
+		/* initialize and configure sensor */
+		if(BME280_Init(&bme[i], &bme_driver[i]) != BME280_OK){
+
+			printf("BME280 %u/0x%02X: Init error\n", bme_channels[i], bme_addresses[i]);
+			return -1;
+		}
+
+		if(BME280_ConfigureAll(&bme[i], &bme_config) != BME280_OK){
+
+			printf("BME280 %u/0x%02X: ConfigureAll error\n", bme_channels[i], bme_addresses[i]);
+			return -1;
+		}
+
+		bme_ptrs[i] = &bme[i];
+	}
+
+	return 0;
+}
+
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct i2c_msg msgs[2];
+	struct i2c_rdwr_ioctl_data xfer;
+
+	/* write register address, then read data with repeated start */
+	msgs[0].addr = drv->i2c_address;
+	msgs[0].flags = 0;
+	msgs[0].len = 1;
+	msgs[0].buf = &reg_addr;
+
+	msgs[1].addr = drv->i2c_address;
+	msgs[1].flags = I2C_M_RD;
+	msgs[1].len = rxlen;
+	msgs[1].buf = rxbuff;
+
+	xfer.msgs = msgs;
+	xfer.nmsgs = 2;
+
+	if(ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer) < 0) return -1;
+	return 0;
+}
+
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	uint8_t buff[2] = { reg_addr, value };
+	struct i2c_msg msg;
+	struct i2c_rdwr_ioctl_data xfer;
+
+	msg.addr = drv->i2c_address;
+	msg.flags = 0;
+	msg.len = 2;
+	msg.buf = buff;
+
+	xfer.msgs = &msg;
+	xfer.nmsgs = 1;
+
+	if(ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer) < 0) return -1;
+	return 0;
+}
+
+void bme280_delay_platform_spec(uint8_t delay_time){
+
+	struct timespec ts = { 0, (long)delay_time * 1000000L };
+	nanosleep(&ts, NULL);
+}
+
+int8_t bme280_fleetread_platform_spec(BME280_FleetRead_t *reads, uint8_t count, void *fleet){
+
+	BME280_Fleet_t *flt = (BME280_Fleet_t *)fleet;
+	struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+	struct i2c_rdwr_ioctl_data xfer;
+	uint8_t i, first = 0, n = 0;
+
+	/* all requests belong to the same channel, which is already selected */
+	for(i = 0; i < count; i++){
+
+		/* two messages per sensor: register address and data */
+		msgs[n].addr = reads[i].dev->driver->i2c_address;
+		msgs[n].flags = 0;
+		msgs[n].len = 1;
+		msgs[n].buf = &reads[i].frame[0];
+		n++;
+
+		msgs[n].addr = reads[i].dev->driver->i2c_address;
+		msgs[n].flags = I2C_M_RD;
+		msgs[n].len = reads[i].len;
+		msgs[n].buf = &reads[i].frame[1];
+		n++;
+
+		/* send when kernel limit of messages is reached or all sensors are queued */
+		if( ((n + 2) > I2C_RDWR_IOCTL_MAX_MSGS) || ((i + 1) == count) ){
+
+			xfer.msgs = msgs;
+			xfer.nmsgs = n;
+
+			/* whole ioctl fails if any sensor doesn't respond, mark all sensors from this part */
+			if(ioctl(*(int *)flt->env_spec_data, I2C_RDWR, &xfer) < 0){
+
+				for(; first <= i; first++) reads[first].res = -1;
+			}
+
+			first = i + 1;
+			n = 0;
+		}
+	}
+
+	/* failure of single part is reported in "res" members only */
+	return 0;
+}
+
+int8_t bme280_select_platform_spec(uint8_t channel, void *fleet){
+
+	BME280_Fleet_t *flt = (BME280_Fleet_t *)fleet;
+	uint8_t mask = (uint8_t)(1U << channel);
+	struct i2c_msg msg;
+	struct i2c_rdwr_ioctl_data xfer;
+
+	/* TCA9548A has single control register, each bit enables one channel */
+	msg.addr = MUX_ADDRESS;
+	msg.flags = 0;
+	msg.len = 1;
+	msg.buf = &mask;
+
+	xfer.msgs = &msg;
+	xfer.nmsgs = 1;
+
+	if(ioctl(*(int *)flt->env_spec_data, I2C_RDWR, &xfer) < 0) return -1;
+	return 0;
+}
@@ -0,0 +1,260 @@
+/**
+  ******************************************************************************
+  * File Name          : main.c
+  * Description        : Record and replay example for Linux i2c-dev
+  ******************************************************************************
+  *
+  * This is an example of use BME280_driver with Linux, i2c-dev interface and
+  * recorder layer. Program works in two modes:
+  * "record <file>" - sensor 0x76 at /dev/i2c-1 is initialized, configured and
+  * read SAMPLES_NR times in forced mode, whole bus traffic is saved to file.
+  * "replay <file>" - the same sequence is executed without hardware, driver is
+  * served with data from file at full speed. Results, number of mismatches
+  * and time per sample are printed, so different driver versions can be
+  * compared with the same traffic. Replay is repeated with bus timing model
+  * of few bus configurations and simulated bus time per sample is printed.
+  * Build: gcc -O2 -I../../.. main.c ../../../bme280.c ../../../bme280_record.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "bme280.h"
+#include "bme280_record.h"
+
+/* public defines */
+#define I2C_DEVICE		"/dev/i2c-1"
+#define SAMPLES_NR		(1000U)
+#define TRACE_SIZE		(64U * 1024U)
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver, i2c_driver;
+BME280_Config_t bme_config;
+BME280_Recorder_t recorder;
+BME280_Replay_t replay;
+
+/* simulated bus configurations */
+static const BME280_BusTiming_t bus_configs[] = {
+
+	{ BME280_BUS_I2C, 100000UL, 0 },
+	{ BME280_BUS_I2C, 400000UL, 0 },
+	{ BME280_BUS_I2C, 1000000UL, 0 },
+	{ BME280_BUS_I2C, 3400000UL, 0 },
+	{ BME280_BUS_SPI, 10000000UL, 0 },
+};
+
+uint8_t trace[TRACE_SIZE];
+
+int i2c_fd;
+
+/* function prototypes */
+int bme_run(int print);
+int record(const char *path);
+int replay_file(const char *path);
+uint32_t bme280_clock_platform_spec(void);
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver);
+void bme280_delay_platform_spec(uint8_t delay_time);
+
+
+	/* main */
+int main(int argc, char **argv){
+
+	if( (3 == argc) && (0 == strcmp(argv[1], "record")) ) return record(argv[2]);
+	if( (3 == argc) && (0 == strcmp(argv[1], "replay")) ) return replay_file(argv[2]);
+
+	printf("usage: %s record|replay <file>\n", argv[0]);
+	return 1;
+}
+
+
+/* functions definitions */
+int bme_run(int print){
+
+	BME280_DataQ_t data;
+	unsigned i;
+	int8_t res;
+
+	/* sensor's options */
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X4;
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.filter = BME280_FILTER_OFF;
+	bme_config.t_stby = BME280_STBY_1000MS;
+	bme_config.spi3w_enable = 0;
+	bme_config.mode = BME280_SLEEPMODE;
+
+	if(BME280_Init(&bme, &bme_driver) != BME280_OK){
+
+		printf("BME280: Init error\n");
+		return -1;
+	}
+
+	if(BME280_ConfigureAll(&bme, &bme_config) != BME280_OK){
+
+		printf("BME280: ConfigureAll error\n");
+		return -1;
+	}
+
+	for(i = 0; i < SAMPLES_NR; i++){
+
+		res = BME280_ReadAllForce_Q(&bme, &data);
+		if(BME280_OK != res) printf("BME280: sample %u error!, res = %d\n", i, res);
+		else if(print && (0 == (i % 100))){
+
+			printf("BME280 sample %u: %.2f degC, %.4f hPa, %.3f %%RH\n", i, data.temp / (double)BME280_TEMP_Q_DIV,
+					data.press / (double)BME280_PRESS_Q_DIV, data.hum / (double)(1UL << BME280_HUM_Q_SHIFT));
+		}
+	}
+
+	return 0;
+}
+
+int record(const char *path){
+
+	FILE *f;
+
+	i2c_fd = open(I2C_DEVICE, O_RDWR);
+	if(i2c_fd < 0){
+
+		perror(I2C_DEVICE);
+		return 1;
+	}
+
+	/* platform specific functions of real sensor */
+	i2c_driver.read = bme280_read_platform_spec;
+	i2c_driver.write = bme280_write_platform_spec;
+	i2c_driver.delay = bme280_delay_platform_spec;
+	i2c_driver.env_spec_data = &i2c_fd;
+	i2c_driver.i2c_address = BME280_I2CADDR_SDOL;
+
+	/* driver talks to recorder, recorder to the sensor */
+	recorder.clock = bme280_clock_platform_spec;
+	BME280_RecorderInit(&recorder, &bme_driver, &i2c_driver, trace, sizeof(trace));
+
+	if(0 != bme_run(1)) return 1;
+
+	f = fopen(path, "wb");
+	if( (NULL == f) || (fwrite(trace, 1, recorder.len, f) != recorder.len) ){
+
+		perror(path);
+		return 1;
+	}
+	fclose(f);
+
+	printf("%u bytes recorded to %s, %u records dropped\n", (unsigned)recorder.len, path, (unsigned)recorder.dropped);
+	return 0;
+}
+
+int replay_file(const char *path){
+
+	FILE *f;
+	size_t len;
+	uint32_t start;
+	unsigned i;
+
+	f = fopen(path, "rb");
+	if(NULL == f){
+
+		perror(path);
+		return 1;
+	}
+	len = fread(trace, 1, sizeof(trace), f);
+	fclose(f);
+
+	if(BME280_ReplayInit(&replay, &bme_driver, trace, (uint32_t)len) != BME280_OK){
+
+		printf("%s: wrong trace file\n", path);
+		return 1;
+	}
+
+	start = bme280_clock_platform_spec();
+	if(0 != bme_run(1)) return 1;
+
+	printf("replayed %u of %u bytes, %u mismatches, %.2f us per sample\n", (unsigned)replay.pos, (unsigned)len,
+			(unsigned)replay.mismatches, (bme280_clock_platform_spec() - start) / (double)SAMPLES_NR);
+
+	if(0 != replay.mismatches) return 1;
+
+	/* the same traffic with bus timing model */
+	for(i = 0; i < (sizeof(bus_configs) / sizeof(bus_configs[0])); i++){
+
+		BME280_ReplayInit(&replay, &bme_driver, trace, (uint32_t)len);
+		replay.bus = &bus_configs[i];
+		if(0 != bme_run(0)) return 1;
+
+		printf("%s %7u Hz: %.1f us on the bus per sample, %u ms of measurements\n",
+				(BME280_BUS_SPI == bus_configs[i].type) ? "SPI" : "I2C", (unsigned)bus_configs[i].clock_hz,
+				(replay.bus_ms * 1000.0 + replay.bus_ns / 1000.0) / SAMPLES_NR, (unsigned)replay.wait_ms);
+	}
+
+	return 0;
+}
+
+uint32_t bme280_clock_platform_spec(void){
+
+	struct timespec ts;
+
+	/* microseconds of monotonic clock */
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct i2c_msg msgs[2];
+	struct i2c_rdwr_ioctl_data xfer;
+
+	/* write register address, then read data with repeated start */
+	msgs[0].addr = drv->i2c_address;
+	msgs[0].flags = 0;
+	msgs[0].len = 1;
+	msgs[0].buf = &reg_addr;
+
+	msgs[1].addr = drv->i2c_address;
+	msgs[1].flags = I2C_M_RD;
+	msgs[1].len = rxlen;
+	msgs[1].buf = rxbuff;
+
+	xfer.msgs = msgs;
+	xfer.nmsgs = 2;
+
+	if(ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer) < 0) return -1;
+	return 0;
+}
+
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	uint8_t buff[2] = { reg_addr, value };
+	struct i2c_msg msg;
+	struct i2c_rdwr_ioctl_data xfer;
+
+	msg.addr = drv->i2c_address;
+	msg.flags = 0;
+	msg.len = 2;
+	msg.buf = buff;
+
+	xfer.msgs = &msg;
+	xfer.nmsgs = 1;
+
+	if(ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer) < 0) return -1;
+	return 0;
+}
+
+void bme280_delay_platform_spec(uint8_t delay_time){
+
+	struct timespec ts = { 0, (long)delay_time * 1000000L };
+	nanosleep(&ts, NULL);
+}
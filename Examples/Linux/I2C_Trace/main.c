@@ -0,0 +1,273 @@
+/**
+  ******************************************************************************
+  * File Name          : main.c
+  * Description        : Trace example for Linux i2c-dev
+  ******************************************************************************
+  *
+  * This is an example of use BME280_driver with Linux, i2c-dev interface and
+  * trace function (#define USE_TRACE in bme280.h must be uncommented). Two
+  * sensors (0x76 and 0x77) are connected to single I2C adapter and each one is
+  * read in forced mode by its own thread. Bus functions share adapter with
+  * mutex. Trace function stores events with CLOCK_MONOTONIC timestamps in
+  * static array, after CYCLES_NR reads of every sensor events are written to
+  * trace.json in Chrome trace format (open with chrome://tracing or
+  * https://ui.perfetto.dev). Every sensor is shown as separate thread, time
+  * spent waiting for the mutex is visible as longer bus events.
+  * Transfer function is not set on purpose: with it forced read is traced as
+  * single transfer event inside trigger phase, without separate wait and adc
+  * read (burst read) events, because they are done inside user function.
+  * Build: gcc -O2 -pthread -I../../.. main.c ../../../bme280.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "bme280.h"
+
+#ifndef USE_TRACE
+#error "uncomment USE_TRACE in bme280.h"
+#endif
+
+/* public defines */
+#define I2C_DEVICE		"/dev/i2c-1"
+#define TRACE_FILE		"trace.json"
+#define SENSORS_NR		(2U)
+#define CYCLES_NR		(20U)
+#define EVENTS_NR		(4096U)
+
+/* public types */
+typedef struct {
+
+	uint64_t ts_ns;
+	uint8_t event;
+	uint8_t edge;
+	uint8_t arg;
+	uint8_t sensor;
+
+} trace_event_t;
+
+/* public variables */
+static const uint8_t bme_addresses[SENSORS_NR] = { BME280_I2CADDR_SDOL, BME280_I2CADDR_SDOH };
+
+BME280_t bme[SENSORS_NR];
+BME280_Driver_t bme_driver[SENSORS_NR];
+BME280_Config_t bme_config;
+
+int i2c_fd;
+pthread_mutex_t i2c_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+trace_event_t trace_events[EVENTS_NR];
+unsigned trace_count;
+
+/* function prototypes */
+int bme_init(void);
+void *bme_thread(void *arg);
+int trace_write(const char *path);
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver);
+void bme280_delay_platform_spec(uint8_t delay_time);
+void bme280_trace_platform_spec(uint8_t event, uint8_t edge, uint8_t arg, void *driver);
+
+
+	/* main */
+int main(void){
+
+	pthread_t threads[SENSORS_NR];
+	uintptr_t i;
+
+	i2c_fd = open(I2C_DEVICE, O_RDWR);
+	if(i2c_fd < 0){
+
+		perror(I2C_DEVICE);
+		return 1;
+	}
+
+	if(0 != bme_init()) return 1;
+
+	/* read all sensors at the same time */
+	for(i = 0; i < SENSORS_NR; i++) pthread_create(&threads[i], NULL, bme_thread, (void *)i);
+	for(i = 0; i < SENSORS_NR; i++) pthread_join(threads[i], NULL);
+
+	if(0 != trace_write(TRACE_FILE)) return 1;
+
+	printf("%u events written to %s\n", trace_count < EVENTS_NR ? trace_count : EVENTS_NR, TRACE_FILE);
+	return 0;
+}
+
+
+/* functions definitions */
+int bme_init(void){
+
+	uint8_t i;
+
+	/* sensor's options */
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X4;
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.filter = BME280_FILTER_OFF;
+	bme_config.t_stby = BME280_STBY_1000MS;
+	bme_config.spi3w_enable = 0;
+	bme_config.mode = BME280_SLEEPMODE;
+
+	for(i = 0; i < SENSORS_NR; i++){
+
+		/* setup driver of every sensor, trace init as well */
+		bme_driver[i].read = bme280_read_platform_spec;
+		bme_driver[i].write = bme280_write_platform_spec;
+		bme_driver[i].delay = bme280_delay_platform_spec;
+		bme_driver[i].env_spec_data = &i2c_fd;
+		bme_driver[i].i2c_address = bme_addresses[i];
+		bme_driver[i].trace = bme280_trace_platform_spec;
+
+		/* initialize and configure sensor */
+		if(BME280_Init(&bme[i], &bme_driver[i]) != BME280_OK){
+
+			printf("BME280 0x%02X: Init error\n", bme_addresses[i]);
+			return -1;
+		}
+
+		if(BME280_ConfigureAll(&bme[i], &bme_config) != BME280_OK){
+
+			printf("BME280 0x%02X: ConfigureAll error\n", bme_addresses[i]);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+void *bme_thread(void *arg){
+
+	uintptr_t i = (uintptr_t)arg;
+	BME280_DataQ_t data;
+	unsigned cycle;
+	int8_t res;
+
+	for(cycle = 0; cycle < CYCLES_NR; cycle++){
+
+		res = BME280_ReadAllForce_Q(&bme[i], &data);
+		if(BME280_OK != res) printf("BME280 0x%02X: error!, res = %d\n", bme_addresses[i], res);
+	}
+
+	return NULL;
+}
+
+int trace_write(const char *path){
+
+	static const char *names[] = { "?", "read", "write", "write_burst", "transfer", "wait" };
+	static const char *phases[] = { "busy-check", "trigger", "burst read", "compensate" };
+	const char *name;
+	unsigned i, n = (trace_count < EVENTS_NR) ? trace_count : EVENTS_NR;
+	FILE *f;
+
+	f = fopen(path, "w");
+	if(NULL == f){
+
+		perror(path);
+		return -1;
+	}
+
+	/* one "B"/"E" pair per event, timestamps in microseconds, thread id is I2C address of sensor */
+	fprintf(f, "{\"traceEvents\":[\n");
+	for(i = 0; i < n; i++){
+
+		if(trace_events[i].event >= BME280_TRACE_BUSY_CHECK) name = phases[(trace_events[i].event - BME280_TRACE_BUSY_CHECK) & 0x03];
+		else name = names[(trace_events[i].event <= BME280_TRACE_WAIT) ? trace_events[i].event : 0];
+
+		fprintf(f, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"arg\":%u}}%s\n",
+				name, (trace_events[i].event >= BME280_TRACE_BUSY_CHECK) ? "phase" : "bus",
+				(BME280_TRACE_BEGIN == trace_events[i].edge) ? 'B' : 'E', trace_events[i].ts_ns / 1000.0,
+				trace_events[i].sensor, trace_events[i].arg, ((i + 1) < n) ? "," : "");
+	}
+	fprintf(f, "],\"displayTimeUnit\":\"ms\"}\n");
+
+	fclose(f);
+	return 0;
+}
+
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct i2c_msg msgs[2];
+	struct i2c_rdwr_ioctl_data xfer;
+	int ret;
+
+	/* write register address, then read data with repeated start */
+	msgs[0].addr = drv->i2c_address;
+	msgs[0].flags = 0;
+	msgs[0].len = 1;
+	msgs[0].buf = &reg_addr;
+
+	msgs[1].addr = drv->i2c_address;
+	msgs[1].flags = I2C_M_RD;
+	msgs[1].len = rxlen;
+	msgs[1].buf = rxbuff;
+
+	xfer.msgs = msgs;
+	xfer.nmsgs = 2;
+
+	pthread_mutex_lock(&i2c_mutex);
+	ret = ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer);
+	pthread_mutex_unlock(&i2c_mutex);
+
+	if(ret < 0) return -1;
+	return 0;
+}
+
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	uint8_t buff[2] = { reg_addr, value };
+	struct i2c_msg msg;
+	struct i2c_rdwr_ioctl_data xfer;
+	int ret;
+
+	msg.addr = drv->i2c_address;
+	msg.flags = 0;
+	msg.len = 2;
+	msg.buf = buff;
+
+	xfer.msgs = &msg;
+	xfer.nmsgs = 1;
+
+	pthread_mutex_lock(&i2c_mutex);
+	ret = ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer);
+	pthread_mutex_unlock(&i2c_mutex);
+
+	if(ret < 0) return -1;
+	return 0;
+}
+
+void bme280_delay_platform_spec(uint8_t delay_time){
+
+	struct timespec ts = { 0, (long)delay_time * 1000000L };
+	nanosleep(&ts, NULL);
+}
+
+void bme280_trace_platform_spec(uint8_t event, uint8_t edge, uint8_t arg, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct timespec ts;
+	unsigned i;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	/* reserve slot without lock, events above array size are dropped */
+	i = __atomic_fetch_add(&trace_count, 1U, __ATOMIC_RELAXED);
+	if(i >= EVENTS_NR) return;
+
+	trace_events[i].ts_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+	trace_events[i].event = event;
+	trace_events[i].edge = edge;
+	trace_events[i].arg = arg;
+	trace_events[i].sensor = drv->i2c_address;
+}
@@ -0,0 +1,195 @@
+/**
+  ******************************************************************************
+  * File Name          : main.c
+  * Description        : Transfer function example for Linux i2c-dev
+  ******************************************************************************
+  *
+  * This is an example of use BME280_driver with Linux, i2c-dev interface and
+  * transfer function (bme280_transfer). Operations passed by the driver are
+  * collected as i2c messages and every run of operations between two delays
+  * is sent with single I2C_RDWR ioctl. Forced measurement (trigger, delay,
+  * status read with ctrl_hum and ctrl_meas, adc read) takes two ioctl calls:
+  * trigger and both reads.
+  * Sensor is read in forced mode every second.
+  * Build: gcc -O2 -I../../.. main.c ../../../bme280.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "bme280.h"
+
+#if !defined(USE_FORCED_MODE) || !defined(USE_FIXED_RESULTS) || defined(USE_STATIC_BUS)
+#error "USE_FORCED_MODE and USE_FIXED_RESULTS must be set and USE_STATIC_BUS not set in bme280.h"
+#endif
+
+/* public defines */
+#define I2C_DEVICE		"/dev/i2c-1"
+#define MSGS_NR			(16U)	// max. messages in single ioctl, below I2C_RDWR_IOCTL_MAX_MSGS
+
+/* public variables */
+BME280_t bme;
+BME280_Driver_t bme_driver;
+BME280_Config_t bme_config;
+
+int i2c_fd;
+
+/* function prototypes */
+int bme_init(void);
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver);
+int8_t bme280_transfer_platform_spec(const BME280_Op_t *ops, uint8_t count, void *driver);
+void bme280_delay_platform_spec(uint8_t delay_time);
+
+
+	/* main */
+int main(void){
+
+	BME280_DataQ_t data;
+	int8_t res;
+
+	i2c_fd = open(I2C_DEVICE, O_RDWR);
+	if(i2c_fd < 0){
+
+		perror(I2C_DEVICE);
+		return 1;
+	}
+
+	if(0 != bme_init()) return 1;
+
+	while(1){
+
+		res = BME280_ReadAllForce_Q(&bme, &data);
+		if(BME280_OK != res) printf("BME280: error!, res = %d\n", res);
+		else printf("T: %.2f degC, P: %.2f hPa, H: %.2f %%RH\n", data.temp / 100.0,
+				(double)data.press / BME280_PRESS_Q_DIV, data.hum / 1024.0);
+
+		sleep(1);
+	}
+}
+
+
+/* functions definitions */
+int bme_init(void){
+
+	/* sensor's options */
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X4;
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.filter = BME280_FILTER_OFF;
+	bme_config.t_stby = BME280_STBY_1000MS;
+	bme_config.spi3w_enable = 0;
+	bme_config.mode = BME280_SLEEPMODE;
+
+	/* read and write are still needed, driver uses them outside of operation lists */
+	bme_driver.read = bme280_read_platform_spec;
+	bme_driver.write = bme280_write_platform_spec;
+	bme_driver.transfer = bme280_transfer_platform_spec;
+	bme_driver.delay = bme280_delay_platform_spec;
+	bme_driver.env_spec_data = &i2c_fd;
+	bme_driver.i2c_address = BME280_I2CADDR_SDOL;
+
+	if(BME280_Init(&bme, &bme_driver) != BME280_OK){
+
+		printf("BME280: Init error\n");
+		return -1;
+	}
+
+	if(BME280_ConfigureAll(&bme, &bme_config) != BME280_OK){
+
+		printf("BME280: ConfigureAll error\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Op_t op = { BME280_OP_READ, reg_addr, 0, rxlen, rxbuff };
+
+	return bme280_transfer_platform_spec(&op, 1, driver);
+}
+
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Op_t op = { BME280_OP_WRITE, reg_addr, value, 0, NULL };
+
+	return bme280_transfer_platform_spec(&op, 1, driver);
+}
+
+int8_t bme280_transfer_platform_spec(const BME280_Op_t *ops, uint8_t count, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct i2c_msg msgs[MSGS_NR];
+	struct i2c_rdwr_ioctl_data xfer;
+	uint8_t wbuff[MSGS_NR][2];
+	unsigned i, n = 0;
+
+	xfer.msgs = msgs;
+
+	/* i <= count - messages are sent at every delay, when array is full and after last operation */
+	for(i = 0; i <= count; i++){
+
+		if( (n > 0) && ( (i == count) || (BME280_OP_DELAY == ops[i].type) || ((n + 2U) > MSGS_NR) ) ){
+
+			xfer.nmsgs = n;
+			if(ioctl(*(int *)drv->env_spec_data, I2C_RDWR, &xfer) < 0) return -1;
+			n = 0;
+		}
+
+		if(i == count) break;
+
+		switch(ops[i].type){
+
+		case BME280_OP_WRITE:
+			/* register address and value */
+			wbuff[n][0] = ops[i].reg_addr;
+			wbuff[n][1] = ops[i].value;
+			msgs[n].addr = drv->i2c_address;
+			msgs[n].flags = 0;
+			msgs[n].len = 2;
+			msgs[n].buf = wbuff[n];
+			n++;
+			break;
+
+		case BME280_OP_READ:
+			/* write register address, then read data with repeated start */
+			wbuff[n][0] = ops[i].reg_addr;
+			msgs[n].addr = drv->i2c_address;
+			msgs[n].flags = 0;
+			msgs[n].len = 1;
+			msgs[n].buf = wbuff[n];
+			n++;
+			msgs[n].addr = drv->i2c_address;
+			msgs[n].flags = I2C_M_RD;
+			msgs[n].len = ops[i].len;
+			msgs[n].buf = ops[i].rxbuff;
+			n++;
+			break;
+
+		case BME280_OP_DELAY:
+			bme280_delay_platform_spec(ops[i].value);
+			break;
+
+		default:
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+void bme280_delay_platform_spec(uint8_t delay_time){
+
+	struct timespec ts = { 0, (long)delay_time * 1000000L };
+	nanosleep(&ts, NULL);
+}
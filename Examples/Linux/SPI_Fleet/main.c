@@ -0,0 +1,226 @@
+/**
+  ******************************************************************************
+  * File Name          : main.c
+  * Description        : Fleet read example for Linux spidev
+  ******************************************************************************
+  *
+  * This is an example of use BME280_driver with Linux and spidev interface.
+  * Several sensors are connected in 4-wire mode, each one has its own
+  * BME280_t and BME280_Driver_t structures and is initialized and configured
+  * to work in normal mode. Adc data of all sensors are read every 10ms by
+  * fleet layer: every sensor is a single full duplex transfer of 9 bytes
+  * (command + adc block) done directly in BME280_FleetRead_t frame.
+  * Note: this is not a batched read. Every BME280 needs its own chip select,
+  * spidev binds one chip select to one device node and can't switch chip
+  * select inside single ioctl, so there is still one SPI_IOC_MESSAGE ioctl
+  * per sensor and no syscall reduction compared to BME280_ReadAllLast_Q
+  * called for every sensor. The gain of fleet layer here is only a common
+  * loop with transfers done in place, without copying of adc data.
+  * Build: gcc -O2 -I../../.. main.c ../../../bme280.c ../../../bme280_fleet.c
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+#include "bme280.h"
+#include "bme280_fleet.h"
+
+/* public defines */
+#define SENSORS_NR		(2U)
+#define SPI_SPEED_HZ	(5000000U)
+
+/* public typedefs */
+struct spi_dev {
+
+	const char *path;	// spidev node, one per chip select
+	int fd;				// file descriptor of opened node
+};
+
+/* public variables */
+struct spi_dev bme_spi[SENSORS_NR] = { { "/dev/spidev0.0", -1 }, { "/dev/spidev0.1", -1 } };
+
+BME280_t bme[SENSORS_NR];
+BME280_t *bme_ptrs[SENSORS_NR];
+BME280_Driver_t bme_driver[SENSORS_NR];
+BME280_Config_t bme_config;
+BME280_DataQ_t bme_data[SENSORS_NR];
+int8_t bme_results[SENSORS_NR];
+
+BME280_FleetRead_t fleet_reads[SENSORS_NR];
+BME280_Fleet_t fleet;
+
+/* function prototypes */
+int bme_init(void);
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver);
+void bme280_delay_platform_spec(uint8_t delay_time);
+int8_t bme280_fleetread_platform_spec(BME280_FleetRead_t *reads, uint8_t count, void *fleet);
+
+
+	/* main */
+int main(void){
+
+	struct timespec period = { 0, 10000000L };
+	uint8_t i;
+
+	if(0 != bme_init()) return 1;
+
+	for(;;){
+
+		nanosleep(&period, NULL);
+
+		/* read all sensors, one ioctl per spidev node */
+		BME280_FleetReadAllLast(&fleet, bme_data, bme_results);
+
+		for(i = 0; i < SENSORS_NR; i++){
+
+			if(BME280_OK == bme_results[i]){
+
+				printf("BME280 %s: %.2f degC, %.4f hPa, %.3f %%RH\n", bme_spi[i].path,
+						bme_data[i].temp / (double)BME280_TEMP_Q_DIV, bme_data[i].press / (double)BME280_PRESS_Q_DIV,
+						bme_data[i].hum / (double)(1UL << BME280_HUM_Q_SHIFT));
+			}
+			else{
+
+				printf("BME280 %s: error!, res = %d\n", bme_spi[i].path, bme_results[i]);
+			}
+		}
+	}
+}
+
+
+/* functions definitions */
+int bme_init(void){
+
+	uint8_t i, mode = SPI_MODE_0;
+	uint32_t speed = SPI_SPEED_HZ;
+
+	/* sensor's options */
+	bme_config.oversampling_h = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_p = BME280_OVERSAMPLING_X1;
+	bme_config.oversampling_t = BME280_OVERSAMPLING_X1;
+	bme_config.filter = BME280_FILTER_OFF;
+	bme_config.t_stby = BME280_STBY_0_5MS;
+	bme_config.spi3w_enable = 0;
+	bme_config.mode = BME280_NORMALMODE;
+
+	for(i = 0; i < SENSORS_NR; i++){
+
+		/* open spidev node of every sensor */
+		bme_spi[i].fd = open(bme_spi[i].path, O_RDWR);
+		if( (bme_spi[i].fd < 0) || (ioctl(bme_spi[i].fd, SPI_IOC_WR_MODE, &mode) < 0) ||
+				(ioctl(bme_spi[i].fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0) ){
+
+			perror(bme_spi[i].path);
+			return -1;
+		}
+
+		/* setup driver of every sensor */
+		bme_driver[i].read = bme280_read_platform_spec;
+		bme_driver[i].write = bme280_write_platform_spec;
+		bme_driver[i].delay = bme280_delay_platform_spec;
+		bme_driver[i].env_spec_data = &bme_spi[i];
+
+		/* initialize and configure sensor */
+		if(BME280_Init(&bme[i], &bme_driver[i]) != BME280_OK){
+
+			printf("BME280 %s: Init error\n", bme_spi[i].path);
+			return -1;
+		}
+
+		if(BME280_ConfigureAll(&bme[i], &bme_config) != BME280_OK){
+
+			printf("BME280 %s: ConfigureAll error\n", bme_spi[i].path);
+			return -1;
+		}
+
+		bme_ptrs[i] = &bme[i];
+	}
+
+	/* setup fleet */
+	fleet.devs = bme_ptrs;
+	fleet.reads = fleet_reads;
+	fleet.count = SENSORS_NR;
+	fleet.read = bme280_fleetread_platform_spec;
+	fleet.env_spec_data = NULL;
+
+	return 0;
+}
+
+int8_t bme280_read_platform_spec(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct spi_dev *spi = (struct spi_dev *)drv->env_spec_data;
+	struct spi_ioc_transfer xfer[2];
+
+	/* set MSB of register address for read */
+	reg_addr |= 0x80;
+
+	memset(xfer, 0, sizeof(xfer));
+	xfer[0].tx_buf = (unsigned long)&reg_addr;
+	xfer[0].len = 1;
+	xfer[1].rx_buf = (unsigned long)rxbuff;
+	xfer[1].len = rxlen;
+
+	if(ioctl(spi->fd, SPI_IOC_MESSAGE(2), xfer) < 0) return -1;
+	return 0;
+}
+
+int8_t bme280_write_platform_spec(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Driver_t *drv = (BME280_Driver_t *)driver;
+	struct spi_dev *spi = (struct spi_dev *)drv->env_spec_data;
+	uint8_t buff[2];
+	struct spi_ioc_transfer xfer;
+
+	/* reset MSB of register address for write */
+	buff[0] = reg_addr & 0x7F;
+	buff[1] = value;
+
+	memset(&xfer, 0, sizeof(xfer));
+	xfer.tx_buf = (unsigned long)buff;
+	xfer.len = 2;
+
+	if(ioctl(spi->fd, SPI_IOC_MESSAGE(1), &xfer) < 0) return -1;
+	return 0;
+}
+
+void bme280_delay_platform_spec(uint8_t delay_time){
+
+	struct timespec ts = { 0, (long)delay_time * 1000000L };
+	nanosleep(&ts, NULL);
+}
+
+int8_t bme280_fleetread_platform_spec(BME280_FleetRead_t *reads, uint8_t count, void *fleet){
+
+	struct spi_ioc_transfer xfer;
+	struct spi_dev *spi;
+	uint8_t i;
+
+	(void)fleet;
+
+	/* every sensor is one full duplex transfer done in place in its frame, one ioctl per spidev node */
+	for(i = 0; i < count; i++){
+
+		spi = (struct spi_dev *)reads[i].dev->driver->env_spec_data;
+
+		reads[i].frame[0] |= 0x80;	// set MSB of register address for read
+
+		memset(&xfer, 0, sizeof(xfer));
+		xfer.tx_buf = (unsigned long)reads[i].frame;
+		xfer.rx_buf = (unsigned long)reads[i].frame;
+		xfer.len = reads[i].len + 1U;
+
+		reads[i].res = (ioctl(spi->fd, SPI_IOC_MESSAGE(1), &xfer) < 0) ? -1 : 0;
+	}
+
+	return 0;
+}
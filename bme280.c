@@ -17,7 +17,18 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 #include "bme280.h"
+#ifdef USE_FLOATS_RESULTS
+#include <math.h>
+#endif
+#ifdef USE_STATIC_BUS
+#ifdef BME280_BUS_HEADER
+#include BME280_BUS_HEADER
+#else
+#include "bme280_bus.h"
+#endif
+#endif
 
 /**
  * @defgroup BME280_priv Private Resources
@@ -30,6 +41,12 @@
  * @defgroup BME280_privmacros Macros
  * @{
  */
+#if defined(USE_INVERSE) && defined(USE_FIXED_RESULTS)
+	/// max. raw pressure searched by inverse functions (300 hPa is below in whole temperature range, like
+	/// #BME280_PRESS_LUT_LAST), compensation wraps around at higher values
+#define INVERSE_PRESS_ADC_MAX	(0xE0000)
+#endif
+
 	/// concatenate two bytes into signed half-word
 #define CAT_I16T(msb, lsb) ((int16_t)(((int16_t)msb << 8) | (int16_t)lsb))
 
@@ -38,6 +55,22 @@
 
 	/// check if x is null
 #define IS_NULL(x)	((NULL == x))
+
+#ifdef USE_TRACE
+	/// report begin or end of event to user defined trace function
+#define TRACE(dev, event, edge, arg)	bme280_trace_event((dev), (event), (edge), (uint8_t)(arg))
+#else
+	/// tracing disabled, nothing to report
+#define TRACE(dev, event, edge, arg)
+#endif
+
+#ifdef USE_LATENCY
+	/// record latency of operation started at "begin" and pass its result
+#define LATENCY(drv, op, begin, res)	bme280_lat_end((drv), (op), (begin), (res))
+#else
+	/// latency not recorded, pass result only
+#define LATENCY(drv, op, begin, res)	(res)
+#endif
 ///@}
 
 /**
@@ -45,13 +78,20 @@
  * @{
  */
 	/// type of read, used as parameter to call #bme280_read_compensate function
-enum { read_all = 0, read_temp, read_press, read_hum};
+enum { read_all = 0, read_temp, read_press, read_hum,
+	read_press_only,	///< pressure without temperature, t_fine from previous read is used
+	read_type_mask = 0x7F,
+	read_forced = 0x80	///< can be OR-ed with type of read to force single measurement before
+};
 
 	/// possible value of "mode" variable inside #BME280_t structure
 enum { sleep_mode = 0x00, forced_mode = 0x01, normal_mode = 0x03 };
 
 	/// possible value of "initialized" variabie inside #BME280_t structure
 enum { not_initialized = 0x00, initialized };
+
+	/// bits of "valid" variable inside #BME280_tfine_memo structure
+enum { memo_press = 0x01, memo_hum = 0x02 };
 ///@}
 
 /**
@@ -73,6 +113,118 @@ struct adc_regs {
  *@{
  */
 
+/**
+ * @brief read registers from sensor
+ *
+ * Function calls user defined read function, via pointer inside #BME280_Driver_t or directly if
+ * #USE_STATIC_BUS is set
+ */
+static int8_t bme280_bus_read(BME280_t *Dev, uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen);
+
+/**
+ * @brief write single register
+ *
+ * Function calls user defined write function, via pointer inside #BME280_Driver_t or directly if
+ * #USE_STATIC_BUS is set
+ */
+static int8_t bme280_bus_write(BME280_t *Dev, uint8_t reg_addr, uint8_t value);
+
+/**
+ * @brief write several registers
+ *
+ * Function writes "count" (register, value) pairs in single transaction with #bme280_writeburst function. If
+ * this function is not set, pairs are written one by one with #bme280_writeregister
+ */
+static int8_t bme280_bus_write_burst(BME280_t *Dev, const uint8_t *pairs, uint8_t count);
+
+/**
+ * @brief count transactions of burst write
+ *
+ * Function returns number of bus transactions used by #bme280_bus_write_burst to write "count" pairs
+ */
+static uint8_t bme280_bus_write_burst_transactions(BME280_t *Dev, uint8_t count);
+
+#if !defined(USE_STATIC_BUS) || defined(USE_FORCED_MODE)
+/**
+ * @brief execute list of operations
+ *
+ * Function passes list of operations to #bme280_transfer function. If this function is not set, operations
+ * are executed one by one with read, write and delay functions
+ */
+static int8_t bme280_bus_transfer(BME280_t *Dev, const BME280_Op_t *ops, uint8_t count);
+#endif
+
+/**
+ * @brief update copy of control registers
+ *
+ * Function updates cache inside *Dev structure after write of single register
+ */
+static void bme280_cache_update(BME280_t *Dev, uint8_t reg_addr, uint8_t value, int8_t res);
+
+/**
+ * @brief wait
+ *
+ * Function calls user defined delay function, via pointer inside #BME280_Driver_t or directly if
+ * #USE_STATIC_BUS is set
+ */
+static void bme280_bus_delay(BME280_t *Dev, uint8_t delay_time);
+
+#ifdef USE_STATS
+/**
+ * @brief count bus transaction
+ *
+ * Function increments *counter, adds bytes and counts interface error if res is non-zero
+ */
+static void bme280_stats_bus(BME280_t *Dev, uint32_t *counter, uint32_t bytes, int8_t res);
+#endif
+
+/**
+ * @brief busy result
+ *
+ * Function returns #BME280_BUSY_ERR and counts it if #USE_STATS is set
+ */
+static int8_t bme280_busy_err(BME280_t *Dev);
+
+#ifdef USE_TRACE
+/**
+ * @brief report trace event
+ *
+ * Function calls user defined trace function if it is set inside #BME280_Driver_t
+ */
+static void bme280_trace_event(BME280_t *Dev, uint8_t event, uint8_t edge, uint8_t arg);
+#endif
+
+#ifdef USE_LATENCY
+/**
+ * @brief start of operation
+ *
+ * Function returns current time from user defined clock function, or 0 if it is not set
+ */
+static uint32_t bme280_lat_begin(BME280_Driver_t *Driver);
+
+/**
+ * @brief end of operation
+ *
+ * Function records time elapsed since "begin" in histogram of operation (if clock and histograms are set)
+ * and returns "res"
+ */
+static int8_t bme280_lat_end(BME280_Driver_t *Driver, uint8_t op, uint32_t begin, int8_t res);
+
+/**
+ * @brief find bucket
+ *
+ * Function returns index of histogram bucket for given value
+ */
+static uint16_t bme280_lat_bucket(uint32_t value);
+
+/**
+ * @brief upper bound of bucket
+ *
+ * Function returns highest value counted in bucket with given index
+ */
+static uint32_t bme280_lat_bucket_top(uint16_t idx);
+#endif
+
 /**
  * @brief read compensation data
  *
@@ -81,6 +233,140 @@ struct adc_regs {
  */
 static int8_t bme280_read_compensation_parameters(BME280_t *Dev);
 
+/**
+ * @brief parse compensation data
+ *
+ * Function parses calibration registers image (#BME280_CALIB_DATA1_LEN + #BME280_CALIB_DATA2_LEN bytes)
+ * into #BME280_calibration_data inside *Dev structure
+ */
+static void bme280_parse_compensation_parameters(BME280_t *Dev, const uint8_t *buff);
+
+/**
+ * @brief initiate sensor
+ *
+ * Function does the work of BME280_Init, public function only records its latency if #USE_LATENCY is set.
+ * Functions below are split from their public functions in the same way.
+ */
+static int8_t bme280_init(BME280_t *Dev, BME280_Driver_t *Driver);
+
+#ifdef USE_CALIB_BLOB
+/**
+ * @brief initiate sensor with calibration data saved before
+ *
+ * Function does the work of BME280_InitWithCalib
+ */
+static int8_t bme280_init_with_calib(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob);
+#endif
+
+/**
+ * @brief attach to running sensor
+ *
+ * Function does the work of BME280_Attach
+ */
+static int8_t bme280_attach(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob);
+
+/**
+ * @brief configure all sensor parameters
+ *
+ * Function does the work of BME280_ConfigureAll
+ */
+static int8_t bme280_configure_all(BME280_t *Dev, BME280_Config_t *Config);
+
+/**
+ * @brief configure changed sensor parameters
+ *
+ * Function does the work of BME280_ConfigureDiff
+ */
+static int8_t bme280_configure_diff(BME280_t *Dev, BME280_Config_t *Config, uint8_t *Saved);
+
+#if defined(USE_FIXED_RESULTS) && defined(USE_FORCED_MODE)
+/**
+ * @brief initiate sensor and take first sample
+ *
+ * Function does the work of BME280_InitForce_Q
+ */
+static int8_t bme280_init_force_q(BME280_t *Dev, BME280_Driver_t *Driver, BME280_Config_t *Config,
+	BME280_DataQ_t *Data);
+#endif
+
+/**
+ * @brief check parameters and attach the driver
+ *
+ * Function checks if all required members of *Driver are set and attaches it to *Dev structure
+ */
+static int8_t bme280_attach_driver(BME280_t *Dev, BME280_Driver_t *Driver);
+
+/**
+ * @brief reset sensor and check its id
+ *
+ * Function performs sensor reset, waits start-up time and checks chip ID
+ */
+static int8_t bme280_reset_check_id(BME280_t *Dev);
+
+/**
+ * @brief check sensor's id
+ *
+ * Function reads chip ID and compares it with #BME280_ID
+ */
+static int8_t bme280_check_id(BME280_t *Dev);
+
+/**
+ * @brief convert configuration into register values
+ *
+ * Function sets ctrl_hum, ctrl_meas and config register values from #BME280_Config_t structure
+ */
+static void bme280_config_to_regs(const BME280_Config_t *Config, uint8_t *ctrl_hum, uint8_t *ctrl_meas,
+		uint8_t *config);
+
+/**
+ * @brief read control registers into cache
+ *
+ * Function reads ctrl_hum, status, ctrl_meas and config registers in single burst and updates cache inside *Dev
+ * structure. Raw registers are stored in *buff (4 bytes)
+ */
+static int8_t bme280_read_regs_cache(BME280_t *Dev, uint8_t *buff);
+
+#ifdef USE_CALIB_BLOB
+/**
+ * @brief calculate CRC-8
+ *
+ * Function calculates CRC-8 (polynomial 0x31, init value 0xFF) of buffer, used to protect calibration blob
+ */
+static uint8_t bme280_crc8(const uint8_t *buff, uint8_t len);
+
+/**
+ * @brief check if calibration blob belongs to sensor
+ *
+ * Function reads dig_T1 and dig_H2 (trimmed individually for every sensor) and compares them with *Blob
+ */
+static int8_t bme280_check_calib(BME280_t *Dev, const uint8_t *Blob);
+#endif
+
+/**
+ * @brief select range of adc registers to read
+ *
+ * Function narrows range of all adc registers to the contiguous block of measured channels, based on
+ * oversampling values stored in cache. Temperature is always inside the range.
+ */
+static void bme280_adc_range(BME280_t *Dev, uint8_t *reg_addr, uint8_t *rxlen);
+
+/**
+ * @brief find skipped channels
+ *
+ * Function returns flags of channels disabled with #BME280_OVERSAMPLING_SKIPP, based on oversampling values
+ * stored in cache. Control registers are read into cache before if it is not valid.
+ */
+static int8_t bme280_skipped(BME280_t *Dev, uint8_t *skipped);
+
+#ifdef USE_TEMP_REUSE
+/**
+ * @brief update temperature reuse state
+ *
+ * Function stores temperature of just refreshed t_fine and sets number of pressure reads which can reuse it
+ */
+static void bme280_temp_reuse_update(BME280_t *Dev, BME280_S32_t temp);
+#endif
+
 /**
  * @brief read and compensate measured values
  *
@@ -91,6 +377,45 @@ static int8_t bme280_read_compensation_parameters(BME280_t *Dev);
 static int8_t bme280_read_compensate(uint8_t read_type, BME280_t *Dev, BME280_S32_t *temp,
 	BME280_U32_t *press, BME280_U32_t *hum);
 
+/**
+ * @brief read and compensate measured values as integers
+ *
+ * Function does the work of #bme280_read_compensate, which only records its latency if #USE_LATENCY is set
+ */
+static int8_t bme280_read_compensate_q(uint8_t read_type, BME280_t *Dev, BME280_S32_t *temp,
+	BME280_U32_t *press, BME280_U32_t *hum);
+
+#ifdef USE_FLOATS_RESULTS
+/**
+ * @brief read and compensate measured values as floats
+ *
+ * Function reads selected adc values from sensor and returns compensated values as floats in deg C, hPa
+ * and %RH. Compensation is performed with floats if #USE_FLOAT_COMPENSATION is set, or with integers
+ * and converted otherwise.
+ */
+static int8_t bme280_read_compensate_float(uint8_t read_type, BME280_t *Dev, float *temp,
+	float *press, float *hum);
+#endif
+
+#ifdef USE_FLOAT_COMPENSATION
+/**
+ * @brief read and compensate measured values with floats
+ *
+ * Function does the work of #bme280_read_compensate_float if #USE_FLOAT_COMPENSATION is set
+ */
+static int8_t bme280_read_compensate_f(uint8_t read_type, BME280_t *Dev, float *temp,
+	float *press, float *hum);
+#endif
+
+/**
+ * @brief read raw adc values
+ *
+ * Function reads selected adc values from sensor and converts them into single variables. Flags of channels
+ * disabled with #BME280_OVERSAMPLING_SKIPP are returned in *skipped, values of these channels are not valid.
+ */
+static int8_t bme280_read_adc(uint8_t read_type, BME280_t *Dev, BME280_S32_t *adc_T,
+	BME280_S32_t *adc_P, BME280_S32_t *adc_H, uint8_t *skipped);
+
 /**
  * @brief convert buffer to single variable
  *
@@ -121,14 +446,118 @@ static BME280_S32_t bme280_compensate_t_s32t(BME280_t *Dev, BME280_S32_t adc_T);
  */
 static BME280_U32_t bme280_compensate_p_u32t(BME280_t *Dev, BME280_S32_t adc_P);
 
+#ifdef USE_PRESS_LUT
+/**
+ * @brief compensate pressure value with lookup table
+ *
+ * Function interpolates pressure between knots of #BME280_press_lut (in adc_P and t_fine), knots are
+ * compensated with #bme280_compensate_p_u32t when they are missing. Output value like
+ * #bme280_compensate_p_u32t.
+ */
+static BME280_U32_t bme280_compensate_p_lut(BME280_t *Dev, BME280_S32_t adc_P);
+
+/**
+ * @brief interpolate pressure in single set of knots
+ *
+ * Function returns pressure interpolated between two knots of selected set of #BME280_press_lut
+ */
+static BME280_U32_t bme280_press_lut_interp(BME280_t *Dev, uint8_t set, uint16_t idx, BME280_S32_t offset);
+
+/**
+ * @brief get single knot of pressure table
+ *
+ * Function returns knot of #BME280_press_lut, compensates it before if needed
+ */
+static BME280_U32_t bme280_press_lut_knot(BME280_t *Dev, uint8_t set, uint16_t idx);
+#endif
+
 /**
  * @brief compensate humidity value
  *
  * Function returns compensated humidity in %RH as unsigned 32bit integer. Output value of "47445"
- * represents 47445/1000 = 47.445 %RH
+ * represents 47445/1024 = 46.333 %RH
  */
 static BME280_U32_t bme280_compensate_h_u32t(BME280_t *Dev, BME280_S32_t adc_H);
 
+#if defined(USE_INVERSE) && defined(USE_FIXED_RESULTS)
+/**
+ * @brief compensate single channel
+ *
+ * Function compensates adc value of channel (read_temp, read_press or read_hum) like #BME280_CompensateTemp,
+ * #BME280_CompensatePress and #BME280_CompensateHum
+ */
+static BME280_S32_t bme280_inverse_eval(BME280_t *Dev, uint8_t channel, BME280_S32_t adc);
+
+/**
+ * @brief find adc value of channel
+ *
+ * Function brackets target starting from last found adc value of channel (or whole range for the first time),
+ * then calls #bme280_inverse_refine.
+ */
+static BME280_S32_t bme280_inverse_search(BME280_t *Dev, uint8_t channel, BME280_S32_t target);
+
+/**
+ * @brief find adc value inside bracket
+ *
+ * Function narrows range lo..hi (flo < target < fhi, values multiplied by sign so they rise) with regula
+ * falsi (Illinois variant) and returns adc value which gives target, or the nearest end
+ */
+static BME280_S32_t bme280_inverse_refine(BME280_t *Dev, uint8_t channel, BME280_S32_t sign, BME280_S32_t target,
+		BME280_S32_t lo, BME280_S32_t flo, BME280_S32_t hi, BME280_S32_t fhi);
+#endif
+
+#ifdef USE_CONST_TIME
+#ifdef USE_64BIT
+/**
+ * @brief divide in constant time
+ *
+ * Function divides two signed 64-bit values with fixed number of iterations and without branches, result is
+ * truncated toward zero like "/" operator. Division by zero returns garbage instead of exception.
+ */
+static BME280_S64_t bme280_div_s64_ct(BME280_S64_t num, BME280_S64_t den);
+#else
+/**
+ * @brief divide in constant time
+ *
+ * Function divides two unsigned 32-bit values with fixed number of iterations and without branches, stores
+ * remainder in *rem. Division by zero returns garbage instead of exception.
+ */
+static BME280_U32_t bme280_div_u32_ct(BME280_U32_t num, BME280_U32_t den, BME280_U32_t *rem);
+#endif
+#endif
+
+#ifdef USE_FLOAT_COMPENSATION
+/**
+ * @brief prepare floating point calibration data
+ *
+ * Function folds constant divisors of floating point formulas into calibration data and stores the result
+ * into #BME280_float_calibration inside *Dev structure.
+ */
+static void bme280_prepare_float_calibration(BME280_t *Dev);
+
+/**
+ * @brief compensate temperature value with floats
+ *
+ * Function returns compensated temperature in DegC. It calculates t_fine_f variable stored inside *Dev
+ * structure as well.
+ */
+static float bme280_compensate_t_float(BME280_t *Dev, BME280_S32_t adc_T);
+
+/**
+ * @brief compensate pressure value with floats
+ *
+ * Function returns compensated pressure in Pa.
+ */
+static float bme280_compensate_p_float(BME280_t *Dev, BME280_S32_t adc_P);
+
+/**
+ * @brief compensate humidity value with floats
+ *
+ * Function returns compensated humidity in %RH.
+ */
+static float bme280_compensate_h_float(BME280_t *Dev, BME280_S32_t adc_H);
+#endif
+
 #ifdef USE_INTEGER_RESULTS
 /**
  * @brief convert temperature to structure
@@ -138,7 +567,7 @@ static BME280_U32_t bme280_compensate_h_u32t(BME280_t *Dev, BME280_S32_t adc_H);
 static void bme280_convert_t_S32_struct(BME280_S32_t temp, BME280_Data_t *data);
 #endif
 
-#ifdef USE_FLOATS_RESULTS
+#if defined(USE_FLOATS_RESULTS) && !defined(USE_FLOAT_COMPENSATION)
 /**
  * @brief convert temperature to float
  *
@@ -156,7 +585,7 @@ static void bme280_convert_t_S32_float(BME280_S32_t temp_in, float *temp_out);
 static void bme280_convert_p_U32_struct(BME280_U32_t press, BME280_Data_t *data);
 #endif
 
-#ifdef USE_FLOATS_RESULTS
+#if defined(USE_FLOATS_RESULTS) && !defined(USE_FLOAT_COMPENSATION)
 /**
  * @brief convert pressure to structure
  *
@@ -174,7 +603,7 @@ static void bme280_convert_p_U32_float(BME280_U32_t press_in, float *press_out);
 static void bme280_convert_h_U32_struct(BME280_U32_t hum, BME280_Data_t *data);
 #endif
 
-#ifdef USE_FLOATS_RESULTS
+#if defined(USE_FLOATS_RESULTS) && !defined(USE_FLOAT_COMPENSATION)
 /**
  * @brief convert humidity to structure
  *
@@ -203,28 +632,22 @@ static int8_t bme280_is_sleep_mode(BME280_t *Dev);
 
 #ifdef USE_FORCED_MODE
 /**
- * @brief check and set forced mode
- *
- * Function checks if conditions to set forced mode are met, calculates and returns required
- * delay time (via *delay pointer) then sets forced mode
- */
-static int8_t bme280_set_forced_mode(BME280_t *Dev, uint8_t *delay);
-
-/**
- * @brief change osrs_x reg value to oversampling
+ * @brief force single measurement and read adc registers
  *
- * Function converts register value to oversampling value
- * f.e. osrs_p = 0x04 then pressure oversampling = x8
+ * Function checks if conditions to set forced mode are met and calculates required delay time with use of
+ * cached control registers. Then it sets forced mode, waits, checks sensor's status and reads "rxlen" adc bytes
+ * from "reg_addr" as single list of operations. Returns #BME280_BUSY_ERR if measurement is not completed and
+ * #BME280_STATE_ERR if oversampling values read together with status differ from cache
  */
-static void bme280_osrs_to_oversampling(uint8_t *osrs);
+static int8_t bme280_forced_read(BME280_t *Dev, uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen);
 
 /**
- * @brief check if sensor is busy
+ * @brief check conditions of forced measurement
  *
- * Function reads "status" register and checks value of two its bits
- * returns #BME280_BUSY_ERR if any of them is set
+ * Function checks (with use of cached control registers) if sensor is in sleep mode and not busy, and
+ * calculates max. measurement time
  */
-static int8_t bme280_busy_check(BME280_t *Dev);
+static int8_t bme280_forced_check(BME280_t *Dev, uint8_t *delay);
 #endif
 ///@}
 ///@}
@@ -236,28 +659,25 @@ static int8_t bme280_busy_check(BME280_t *Dev);
 	/* function that initiates minimum required parameters to operate with a sensor */
 int8_t BME280_Init(BME280_t *Dev, BME280_Driver_t *Driver){
 
-	int8_t res = BME280_OK;
-	uint8_t id = 0;
-
-	/* check parameters */
-	if( IS_NULL(Dev) || IS_NULL(Driver) || IS_NULL(Driver->write) || IS_NULL(Driver->read) ||
-			IS_NULL(Driver->delay) ) return BME280_PARAM_ERR;
+#ifdef USE_LATENCY
+	uint32_t begin = bme280_lat_begin(Driver);
+#endif
 
-	/* attach the driver to main structure */
-	Dev->driver = Driver;
+	return LATENCY(Driver, BME280_LAT_INIT, begin, bme280_init(Dev, Driver));
+}
 
-	/* perform sensor reset */
-	res = BME280_Reset(Dev);
-	if(BME280_OK != res) return res;
+	/* private function to initiate minimum required parameters to operate with a sensor */
+static int8_t bme280_init(BME280_t *Dev, BME280_Driver_t *Driver){
 
-	/* Start-up time = 2ms */
-	Dev->driver->delay(2);
+	int8_t res = BME280_OK;
 
-	/* read and check chip ID */
-	res = Dev->driver->read(BME280_ID_ADDR, &id, 1, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	/* check parameters and attach the driver to main structure */
+	res = bme280_attach_driver(Dev, Driver);
+	if(BME280_OK != res) return res;
 
-	if(BME280_ID != id) return BME280_ID_ERR;
+	/* perform sensor reset and check chip ID */
+	res = bme280_reset_check_id(Dev);
+	if(BME280_OK != res) return res;
 
 	/* read, parse and store compensation data */
 	res = bme280_read_compensation_parameters(Dev);
@@ -266,38 +686,301 @@ int8_t BME280_Init(BME280_t *Dev, BME280_Driver_t *Driver){
 	return res;
 }
 
-	/* Function  configures all sensor parameters at once */
-int8_t BME280_ConfigureAll(BME280_t *Dev, BME280_Config_t *Config){
+#ifdef USE_CALIB_BLOB
+	/* function that initiates sensor with calibration data saved before */
+int8_t BME280_InitWithCalib(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob){
 
-	int8_t res = BME280_OK;
-	uint8_t ctrl_hum = 0, ctrl_meas = 0, config = 0;
+#ifdef USE_LATENCY
+	uint32_t begin = bme280_lat_begin(Driver);
+#endif
 
-	/* check parameters */
-	if( IS_NULL(Dev) || IS_NULL(Config) ) return BME280_PARAM_ERR;
+	return LATENCY(Driver, BME280_LAT_INIT, begin, bme280_init_with_calib(Dev, Driver, Blob));
+}
 
-	/* check if sensor is initialized and in sleep mode */
-	res = bme280_is_sleep_mode(Dev);
+	/* private function to initiate sensor with calibration data saved before */
+static int8_t bme280_init_with_calib(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob){
+
+	int8_t res = BME280_OK;
+
+	/* check parameters and attach the driver to main structure */
+	if( IS_NULL(Blob) ) return BME280_PARAM_ERR;
+	res = bme280_attach_driver(Dev, Driver);
+	if(BME280_OK != res) return res;
+
+	/* check if blob is not corrupted */
+	if(bme280_crc8(Blob, BME280_CALIB_DATA1_LEN + BME280_CALIB_DATA2_LEN) !=
+			Blob[BME280_CALIB_DATA1_LEN + BME280_CALIB_DATA2_LEN]){
+
+		return BME280_CALIB_ERR;
+	}
+
+	/* perform sensor reset and check chip ID */
+	res = bme280_reset_check_id(Dev);
+	if(BME280_OK != res) return res;
+
+	/* check if blob comes from this sensor */
+	res = bme280_check_calib(Dev, Blob);
+	if(BME280_OK != res) return res;
+
+	/* parse and store compensation data from blob instead of reading them */
+	bme280_parse_compensation_parameters(Dev, Blob);
+
+	Dev->initialized = initialized;
+	return res;
+}
+
+	/* function exports calibration data of initialized sensor */
+int8_t BME280_GetCalibBlob(BME280_t *Dev, uint8_t *Blob){
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Blob) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+	/* build image of calibration registers, the same as read from sensor */
+	Blob[0] = (uint8_t)Dev->trimm.dig_T1;
+	Blob[1] = (uint8_t)(Dev->trimm.dig_T1 >> 8);
+	Blob[2] = (uint8_t)Dev->trimm.dig_T2;
+	Blob[3] = (uint8_t)((uint16_t)Dev->trimm.dig_T2 >> 8);
+	Blob[4] = (uint8_t)Dev->trimm.dig_T3;
+	Blob[5] = (uint8_t)((uint16_t)Dev->trimm.dig_T3 >> 8);
+
+	Blob[6] = (uint8_t)Dev->trimm.dig_P1;
+	Blob[7] = (uint8_t)(Dev->trimm.dig_P1 >> 8);
+	Blob[8] = (uint8_t)Dev->trimm.dig_P2;
+	Blob[9] = (uint8_t)((uint16_t)Dev->trimm.dig_P2 >> 8);
+	Blob[10] = (uint8_t)Dev->trimm.dig_P3;
+	Blob[11] = (uint8_t)((uint16_t)Dev->trimm.dig_P3 >> 8);
+	Blob[12] = (uint8_t)Dev->trimm.dig_P4;
+	Blob[13] = (uint8_t)((uint16_t)Dev->trimm.dig_P4 >> 8);
+	Blob[14] = (uint8_t)Dev->trimm.dig_P5;
+	Blob[15] = (uint8_t)((uint16_t)Dev->trimm.dig_P5 >> 8);
+	Blob[16] = (uint8_t)Dev->trimm.dig_P6;
+	Blob[17] = (uint8_t)((uint16_t)Dev->trimm.dig_P6 >> 8);
+	Blob[18] = (uint8_t)Dev->trimm.dig_P7;
+	Blob[19] = (uint8_t)((uint16_t)Dev->trimm.dig_P7 >> 8);
+	Blob[20] = (uint8_t)Dev->trimm.dig_P8;
+	Blob[21] = (uint8_t)((uint16_t)Dev->trimm.dig_P8 >> 8);
+	Blob[22] = (uint8_t)Dev->trimm.dig_P9;
+	Blob[23] = (uint8_t)((uint16_t)Dev->trimm.dig_P9 >> 8);
+
+	Blob[24] = Dev->trimm.dig_H1;
+	Blob[25] = (uint8_t)Dev->trimm.dig_H2;
+	Blob[26] = (uint8_t)((uint16_t)Dev->trimm.dig_H2 >> 8);
+	Blob[27] = Dev->trimm.dig_H3;
+	Blob[28] = (uint8_t)((uint16_t)Dev->trimm.dig_H4 >> 4);
+	Blob[29] = (uint8_t)(((uint16_t)Dev->trimm.dig_H4 & 0x0F) | (((uint16_t)Dev->trimm.dig_H5 & 0x0F) << 4));
+	Blob[30] = (uint8_t)((uint16_t)Dev->trimm.dig_H5 >> 4);
+	Blob[31] = (uint8_t)Dev->trimm.dig_H6;
+
+	/* protect the data with CRC */
+	Blob[BME280_CALIB_DATA1_LEN + BME280_CALIB_DATA2_LEN] =
+			bme280_crc8(Blob, BME280_CALIB_DATA1_LEN + BME280_CALIB_DATA2_LEN);
+
+	return BME280_OK;
+}
+#endif
+
+	/* function that attaches to running sensor without reset */
+int8_t BME280_Attach(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob){
+
+#ifdef USE_LATENCY
+	uint32_t begin = bme280_lat_begin(Driver);
+#endif
+
+	return LATENCY(Driver, BME280_LAT_INIT, begin, bme280_attach(Dev, Driver, Blob));
+}
+
+	/* private function to attach to running sensor without reset */
+static int8_t bme280_attach(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob){
+
+	int8_t res = BME280_OK;
+	uint8_t buff[4];
+
+	/* check parameters and attach the driver to main structure */
+	res = bme280_attach_driver(Dev, Driver);
+	if(BME280_OK != res) return res;
+
+#ifdef USE_CALIB_BLOB
+	/* check if blob is not corrupted */
+	if( !IS_NULL(Blob) && (bme280_crc8(Blob, BME280_CALIB_DATA1_LEN + BME280_CALIB_DATA2_LEN) !=
+			Blob[BME280_CALIB_DATA1_LEN + BME280_CALIB_DATA2_LEN]) ){
+
+		return BME280_CALIB_ERR;
+	}
+#else
+	if( !IS_NULL(Blob) ) return BME280_PARAM_ERR;
+#endif
+
+	/* check chip ID, no reset here */
+	res = bme280_check_id(Dev);
+	if(BME280_OK != res) return res;
+
+	/* read ctrl_hum, status, ctrl_meas and config registers, keep them in cache */
+	res = bme280_read_regs_cache(Dev, buff);
+	if(BME280_OK != res) return res;
+
+	/* calibration data are being copied after power-on, sensor is not ready yet */
+	if(0 != (buff[1] & 0x01)) return bme280_busy_err(Dev);	// 0x01 - "im_update" bit
+
+	/* take calibration data from blob or read them from sensor */
+#ifdef USE_CALIB_BLOB
+	if( !IS_NULL(Blob) ){
+
+		/* check if blob comes from this sensor */
+		res = bme280_check_calib(Dev, Blob);
+		if(BME280_OK != res) return res;
+
+		bme280_parse_compensation_parameters(Dev, Blob);
+	}
+	else
+#endif
+	{
+		res = bme280_read_compensation_parameters(Dev);
+		if(BME280_OK != res) return res;
+	}
+
+	/* rebuild operating mode, forced conversion ends in sleep mode by itself */
+	Dev->mode = ((buff[2] & 0x03) == normal_mode) ? normal_mode : sleep_mode;
+
+	Dev->initialized = initialized;
+	return res;
+}
+
+	/* Function  configures all sensor parameters at once */
+int8_t BME280_ConfigureAll(BME280_t *Dev, BME280_Config_t *Config){
+
+#ifdef USE_LATENCY
+	BME280_Driver_t *driver = IS_NULL(Dev) ? NULL : Dev->driver;
+	uint32_t begin = bme280_lat_begin(driver);
+#endif
+
+	return LATENCY(driver, BME280_LAT_CONFIGURE, begin, bme280_configure_all(Dev, Config));
+}
+
+	/* private function to configure all sensor parameters at once */
+static int8_t bme280_configure_all(BME280_t *Dev, BME280_Config_t *Config){
+
+	int8_t res = BME280_OK;
+	uint8_t ctrl_hum = 0, ctrl_meas = 0, config = 0;
+	uint8_t pairs[6];
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Config) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized and in sleep mode */
+	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
 	/* set the data from Config structure to the right positions in
 	 * sensor registers */
-	ctrl_hum = Config->oversampling_h & 0x07;	//0x07 - 0b00000111
+	bme280_config_to_regs(Config, &ctrl_hum, &ctrl_meas, &config);
+
+	/* send three config bytes to the device, ctrl_meas as the last one because
+	 * it may start normal mode (writes to config in normal mode may be ignored) */
+	pairs[0] = BME280_CTRL_HUM_ADDR;
+	pairs[1] = ctrl_hum;
+	pairs[2] = BME280_CONFIG_ADDR;
+	pairs[3] = config;
+	pairs[4] = BME280_CTRL_MEAS_ADDR;
+	pairs[5] = ctrl_meas;
+	res = bme280_bus_write_burst(Dev, pairs, 3);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
-	ctrl_meas |= (Config->oversampling_t << 5) & 0xE0; 	//0xE0 - 0b11100000
-	ctrl_meas |= (Config->oversampling_p << 2) & 0x1C;	//0x1C - 0b00011100
-	ctrl_meas |= Config->mode & 0x03;					//0x03 - 0b00000011
+	/* set oparing mode inside Dev structure */
+	if(BME280_SLEEPMODE == Config->mode){
 
-	config |= (Config->t_stby << 5) & 0xE0;	//0xE0 - 0b11100000
-	config |= (Config->filter << 2) & 0x1C;	//0x1C - 0b00011100
-	config |= Config->spi3w_enable & 0x01;	//0x01 - 0b00000001
+		Dev->mode = sleep_mode;
+	}
+	else if(BME280_FORCEDMODE == Config->mode){
 
-	/* send three config bytes to the device */
-	res = Dev->driver->write(BME280_CTRL_HUM_ADDR, ctrl_hum, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
-	res = Dev->driver->write(BME280_CTRL_MEAS_ADDR, ctrl_meas, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
-	res = Dev->driver->write(BME280_CONFIG_ADDR, config, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+		Dev->mode = forced_mode;
+	}
+	else if(BME280_NORMALMODE == Config->mode){
+
+		Dev->mode = normal_mode;
+	}
+
+	return res;
+}
+
+	/* Function configures sensor writing only registers that differ from current state */
+int8_t BME280_ConfigureDiff(BME280_t *Dev, BME280_Config_t *Config, uint8_t *Saved){
+
+#ifdef USE_LATENCY
+	BME280_Driver_t *driver = IS_NULL(Dev) ? NULL : Dev->driver;
+	uint32_t begin = bme280_lat_begin(driver);
+#endif
+
+	return LATENCY(driver, BME280_LAT_CONFIGURE, begin, bme280_configure_diff(Dev, Config, Saved));
+}
+
+	/* private function to configure sensor writing only registers that differ from current state */
+static int8_t bme280_configure_diff(BME280_t *Dev, BME280_Config_t *Config, uint8_t *Saved){
+
+	int8_t res = BME280_OK;
+	uint8_t ctrl_hum, ctrl_meas, config, writes = 0, restart = 0, transactions = 0, all;
+	uint8_t buff[4], pairs[8];
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Config) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+	/* state of registers is unknown, read it once */
+	if(0 == Dev->regs.valid){
+
+		res = bme280_read_regs_cache(Dev, buff);
+		if(BME280_OK != res) return res;
+		transactions++;
+	}
+
+	bme280_config_to_regs(Config, &ctrl_hum, &ctrl_meas, &config);
+
+	/* writes to config register in normal mode may be ignored, so sensor must be
+	 * stopped before - check documentation */
+	if( (config != Dev->regs.config) && (normal_mode == (Dev->regs.ctrl_meas & 0x03)) ){
+
+		pairs[2 * writes] = BME280_CTRL_MEAS_ADDR;
+		pairs[(2 * writes) + 1] = Dev->regs.ctrl_meas & 0xFC;
+		writes++;
+		restart = 1;
+	}
+
+	if(ctrl_hum != Dev->regs.ctrl_hum){
+
+		pairs[2 * writes] = BME280_CTRL_HUM_ADDR;
+		pairs[(2 * writes) + 1] = ctrl_hum;
+		writes++;
+
+		/* ctrl_hum takes effect after ctrl_meas write only, so force it below */
+		restart = 1;
+	}
+
+	if(config != Dev->regs.config){
+
+		pairs[2 * writes] = BME280_CONFIG_ADDR;
+		pairs[(2 * writes) + 1] = config;
+		writes++;
+	}
+
+	/* ctrl_meas as the last one, it starts measurements if requested */
+	if( restart || (ctrl_meas != Dev->regs.ctrl_meas) ){
+
+		pairs[2 * writes] = BME280_CTRL_MEAS_ADDR;
+		pairs[(2 * writes) + 1] = ctrl_meas;
+		writes++;
+	}
+
+	/* send all changes in single transaction */
+	if(writes > 0){
+
+		res = bme280_bus_write_burst(Dev, pairs, writes);
+		if(BME280_OK != res) return BME280_INTERFACE_ERR;
+		transactions += bme280_bus_write_burst_transactions(Dev, writes);
+	}
 
 	/* set oparing mode inside Dev structure */
 	if(BME280_SLEEPMODE == Config->mode){
@@ -313,19 +996,136 @@ int8_t BME280_ConfigureAll(BME280_t *Dev, BME280_Config_t *Config){
 		Dev->mode = normal_mode;
 	}
 
+	/* compare with transactions of BME280_ConfigureAll (3 registers written with single burst) */
+	all = bme280_bus_write_burst_transactions(Dev, 3);
+	if( !IS_NULL(Saved) ) *Saved = (transactions < all) ? (uint8_t)(all - transactions) : 0;
+
 	return res;
 }
 
+#ifdef USE_TEMP_REUSE
+	/* function sets temperature reuse for pressure reads */
+int8_t BME280_SetTempReuse(BME280_t *Dev, uint8_t Period, uint16_t MaxDelta){
+
+	/* check parameters */
+	if( IS_NULL(Dev) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+	/* next pressure read refreshes t_fine */
+	Dev->t_reuse.period = Period;
+	Dev->t_reuse.max_delta = MaxDelta;
+	Dev->t_reuse.left = 0;
+	Dev->t_reuse.valid = 0;
+
+	return BME280_OK;
+}
+#endif
+
+#ifdef USE_STATS
+	/* function reads performance counters of sensor */
+int8_t BME280_GetStats(BME280_t *Dev, BME280_Stats_t *Stats){
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Stats) ) return BME280_PARAM_ERR;
+
+	*Stats = Dev->stats;
+
+	return BME280_OK;
+}
+
+	/* function clears performance counters of sensor */
+int8_t BME280_ResetStats(BME280_t *Dev){
+
+	/* check parameters */
+	if( IS_NULL(Dev) ) return BME280_PARAM_ERR;
+
+	memset(&Dev->stats, 0, sizeof(Dev->stats));
+
+	return BME280_OK;
+}
+#endif
+
+#ifdef USE_LATENCY
+	/* function calculates percentile of latency */
+int8_t BME280_LatencyPercentile(const BME280_Latency_t *Latency, uint8_t Op, uint16_t Rank, uint32_t *Value){
+
+	const BME280_Hist_t *hist;
+	uint32_t target, rem, sum = 0;
+	uint16_t i;
+
+	/* check parameters */
+	if( IS_NULL(Latency) || IS_NULL(Value) || (Op >= BME280_LAT_OPS) || (Rank > 10000) ) return BME280_PARAM_ERR;
+
+	hist = &Latency->op[Op];
+	*Value = 0;
+	if(0 == hist->total) return BME280_OK;
+
+	/* number of calls up to percentile, rounded up and split to avoid overflow */
+	rem = (hist->total % 10000) * Rank;
+	target = (hist->total / 10000) * Rank + (rem / 10000) + ((0 != (rem % 10000)) ? 1 : 0);
+	if(0 == target) target = 1;
+
+	for(i = 0; i < BME280_LAT_BUCKETS; i++){
+
+		sum += hist->count[i];
+		if(sum >= target) break;
+	}
+
+	/* upper bound of bucket, but not more than max. recorded value */
+	*Value = (i < (BME280_LAT_BUCKETS - 1)) ? bme280_lat_bucket_top(i) : hist->max;
+	if(*Value > hist->max) *Value = hist->max;
+
+	return BME280_OK;
+}
+
+	/* function adds histograms to other ones */
+int8_t BME280_LatencyMerge(BME280_Latency_t *Dst, const BME280_Latency_t *Src){
+
+	uint8_t op;
+	uint16_t i;
+
+	/* check parameters */
+	if( IS_NULL(Dst) || IS_NULL(Src) ) return BME280_PARAM_ERR;
+
+	for(op = 0; op < BME280_LAT_OPS; op++){
+
+		for(i = 0; i < BME280_LAT_BUCKETS; i++) Dst->op[op].count[i] += Src->op[op].count[i];
+
+		Dst->op[op].total += Src->op[op].total;
+		if(Src->op[op].max > Dst->op[op].max) Dst->op[op].max = Src->op[op].max;
+	}
+
+	return BME280_OK;
+}
+
+	/* function clears histograms */
+int8_t BME280_LatencyReset(BME280_Latency_t *Latency){
+
+	/* check parameters */
+	if( IS_NULL(Latency) ) return BME280_PARAM_ERR;
+
+	memset(Latency, 0, sizeof(BME280_Latency_t));
+
+	return BME280_OK;
+}
+#endif
+
 	/* function performs power-on reset procedure for sensor */
 int8_t BME280_Reset(BME280_t *Dev){
 
 	int8_t res = BME280_OK;
 
 	/* check parameter */
+#ifdef USE_STATIC_BUS
+	if( IS_NULL(Dev) ) return BME280_PARAM_ERR;
+#else
 	if( IS_NULL(Dev) || IS_NULL(Dev->driver->write) ) return BME280_PARAM_ERR;
+#endif
 
 	/* write reset commad to reset register */
-	res = Dev->driver->write(BME280_RESET_ADDR, BME280_RESET_VALUE, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_RESET_ADDR, BME280_RESET_VALUE);
 
 	/* set mode to default */
 	Dev->mode = sleep_mode;
@@ -333,6 +1133,50 @@ int8_t BME280_Reset(BME280_t *Dev){
 	return res;
 }
 
+	/* function returns channels disabled with BME280_OVERSAMPLING_SKIPP */
+int8_t BME280_GetSkipped(BME280_t *Dev, uint8_t *Skipped){
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Skipped) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+	return bme280_skipped(Dev, Skipped);
+}
+
+#ifdef USE_FORCED_MODE
+	/* function starts single measurement without waiting for result */
+int8_t BME280_StartForced(BME280_t *Dev, uint8_t *Delay){
+
+	int8_t res = BME280_OK;
+	uint8_t delay;
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Delay) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized and in sleep mode */
+	res = bme280_is_sleep_mode(Dev);
+	if(BME280_OK != res) return res;
+
+	/* check conditions and calculate delay */
+	TRACE(Dev, BME280_TRACE_BUSY_CHECK, BME280_TRACE_BEGIN, 0);
+	res = bme280_forced_check(Dev, &delay);
+	TRACE(Dev, BME280_TRACE_BUSY_CHECK, BME280_TRACE_END, 0);
+	if(BME280_OK != res) return res;
+
+	/* set forced mode */
+	TRACE(Dev, BME280_TRACE_TRIGGER, BME280_TRACE_BEGIN, delay);
+	res = bme280_bus_write(Dev, BME280_CTRL_MEAS_ADDR, (Dev->regs.ctrl_meas & 0xFC) | BME280_FORCEDMODE);
+	TRACE(Dev, BME280_TRACE_TRIGGER, BME280_TRACE_END, delay);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+
+	*Delay = delay;
+
+	return res;
+}
+#endif
+
 #ifdef USE_GETTERS
 	/* Function reads current operation mode from sensor */
 int8_t BME280_GetMode(BME280_t *Dev, uint8_t *Mode){
@@ -348,7 +1192,7 @@ int8_t BME280_GetMode(BME280_t *Dev, uint8_t *Mode){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse mode values from ctrl_meas */
@@ -378,7 +1222,7 @@ int8_t BME280_GetPOvs(BME280_t *Dev, uint8_t *POvs){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse pressure oversampling value from ctrl_meas */
@@ -404,7 +1248,7 @@ int8_t BME280_GetTOvs(BME280_t *Dev, uint8_t *TOvs){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse temperature oversampling value from ctrl_meas */
@@ -431,7 +1275,7 @@ int8_t BME280_GetHOvs(BME280_t *Dev, uint8_t *HOvs){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of ctrl_hum register from sensor */
-	res = Dev->driver->read(BME280_CTRL_HUM_ADDR, &ctrl_hum, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_HUM_ADDR, &ctrl_hum, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse humidity oversampling value from ctrl_hum */
@@ -457,7 +1301,7 @@ int8_t BME280_GetTStby(BME280_t *Dev, uint8_t *TStby){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of config register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse standby time value from config */
@@ -483,7 +1327,7 @@ int8_t BME280_GetTFilter(BME280_t *Dev, uint8_t *Filter){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of config register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse filter value from config */
@@ -509,7 +1353,7 @@ int8_t BME280_Is3WireSPIEnabled(BME280_t *Dev, uint8_t *Result){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* parse mode values from ctrl_meas */
@@ -537,7 +1381,7 @@ int8_t BME280_SetMode(BME280_t *Dev, uint8_t Mode){
 	if(BME280_NO_INIT_ERR == res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current mode differs from requested */
@@ -548,7 +1392,7 @@ int8_t BME280_SetMode(BME280_t *Dev, uint8_t Mode){
 	/* send new ctrl_meas value to sensor if required */
 	ctrl_meas &= 0xFC;	//0xFC - 0b11111100
 	ctrl_meas |= Mode;
-	res = Dev->driver->write(BME280_CTRL_MEAS_ADDR, ctrl_meas, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CTRL_MEAS_ADDR, ctrl_meas);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* update value inside Dev structure */
@@ -571,7 +1415,7 @@ int8_t BME280_SetPOvs(BME280_t *Dev, uint8_t POvs){
 	if(BME280_OK != res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current value differs from requested */
@@ -581,7 +1425,7 @@ int8_t BME280_SetPOvs(BME280_t *Dev, uint8_t POvs){
 	/* send new ctrl_meas value to sensor if required */
 	ctrl_meas &= 0xE3;	//0xE3 - 0b11100011
 	ctrl_meas |= (POvs << 2);
-	res = Dev->driver->write(BME280_CTRL_MEAS_ADDR, ctrl_meas, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CTRL_MEAS_ADDR, ctrl_meas);
 
 	return res;
 }
@@ -600,7 +1444,7 @@ int8_t BME280_SetTOvs(BME280_t *Dev, uint8_t TOvs){
 	if(BME280_OK != res) return res;
 
 	/* read value of ctrl_meas register from sensor */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &ctrl_meas, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current value differs from requested */
@@ -610,7 +1454,7 @@ int8_t BME280_SetTOvs(BME280_t *Dev, uint8_t TOvs){
 	/* send new ctrl_meas value to sensor if required */
 	ctrl_meas &= 0x1F;	//0x1F - 0b00011111
 	ctrl_meas |= (TOvs << 5);
-	res = Dev->driver->write(BME280_CTRL_MEAS_ADDR, ctrl_meas, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CTRL_MEAS_ADDR, ctrl_meas);
 
 	return res;
 }
@@ -620,6 +1464,7 @@ int8_t BME280_SetHOvs(BME280_t *Dev, uint8_t HOvs){
 
 	int8_t res = BME280_OK;
 	uint8_t tmp = 0;
+	uint8_t pairs[4];
 
 	/* check parameters */
 	if( IS_NULL(Dev) || (HOvs > BME280_OVERSAMPLING_X16) ) return BME280_PARAM_ERR;
@@ -628,15 +1473,17 @@ int8_t BME280_SetHOvs(BME280_t *Dev, uint8_t HOvs){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* send requested value to sensor */
-	res = Dev->driver->write(BME280_CTRL_HUM_ADDR, HOvs, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
-
 	/* to make the change effective we need to write ctrl_meas register,
 	 * check documentation */
-	res = Dev->driver->read(BME280_CTRL_MEAS_ADDR, &tmp, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CTRL_MEAS_ADDR, &tmp, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
-	res = Dev->driver->write(BME280_CTRL_MEAS_ADDR, tmp, Dev->driver);
+
+	/* send requested value and ctrl_meas to sensor */
+	pairs[0] = BME280_CTRL_HUM_ADDR;
+	pairs[1] = HOvs;
+	pairs[2] = BME280_CTRL_MEAS_ADDR;
+	pairs[3] = tmp;
+	res = bme280_bus_write_burst(Dev, pairs, 2);
 
 	return res;
 }
@@ -655,7 +1502,7 @@ int8_t BME280_SetTStby(BME280_t *Dev, uint8_t TStby){
 	if(BME280_OK != res) return res;
 
 	/* read value of config register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current value differs from requested */
@@ -665,7 +1512,7 @@ int8_t BME280_SetTStby(BME280_t *Dev, uint8_t TStby){
 	/* send new config value to sensor if required */
 	config &= 0x1F;	//0x1F - 0b00011111
 	config |= (TStby << 5);
-	res = Dev->driver->write(BME280_CONFIG_ADDR, config, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CONFIG_ADDR, config);
 
 	return res;
 }
@@ -684,7 +1531,7 @@ int8_t BME280_SetFilter(BME280_t *Dev, uint8_t Filter){
 	if(BME280_OK != res) return res;
 
 	/* read value of config register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current value differs from requested */
@@ -694,7 +1541,7 @@ int8_t BME280_SetFilter(BME280_t *Dev, uint8_t Filter){
 	/* send new config value to sensor if required */
 	config &= 0xE3;	//0xE3 - 0b11100011
 	config |= (Filter << 2);
-	res = Dev->driver->write(BME280_CONFIG_ADDR, config, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CONFIG_ADDR, config);
 
 	return res;
 }
@@ -713,7 +1560,7 @@ int8_t BME280_Enable3WireSPI(BME280_t *Dev){
 	if(BME280_OK != res) return res;
 
 	/* read value of config register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current value differs from requested */
@@ -723,7 +1570,7 @@ int8_t BME280_Enable3WireSPI(BME280_t *Dev){
 	/* send new config value to sensor if required */
 	config &= 0xFE;	//0xFE - 0b11111110
 	config |= 0x01;
-	res = Dev->driver->write(BME280_CONFIG_ADDR, config, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CONFIG_ADDR, config);
 
 	return res;
 }
@@ -742,7 +1589,7 @@ int8_t BME280_Disable3WireSPI(BME280_t *Dev){
 	if(BME280_OK != res) return res;
 
 	/* read value of config register from sensor */
-	res = Dev->driver->read(BME280_CONFIG_ADDR, &config, 1, Dev->driver);
+	res = bme280_bus_read(Dev, BME280_CONFIG_ADDR, &config, 1);
 	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
 	/* check if current value differs from requested */
@@ -751,7 +1598,7 @@ int8_t BME280_Disable3WireSPI(BME280_t *Dev){
 
 	/* send new config value to sensor if required */
 	config &= 0xFE;	//0xFE - 0b11111110
-	res = Dev->driver->write(BME280_CONFIG_ADDR, config, Dev->driver);
+	res = bme280_bus_write(Dev, BME280_CONFIG_ADDR, config);
 
 	return res;
 }
@@ -879,7 +1726,6 @@ int8_t BME280_ReadAllForce(BME280_t *Dev, BME280_Data_t *Data){
 	int8_t res = BME280_OK;
 	BME280_S32_t temp;
 	BME280_U32_t press, hum;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Data) ) return BME280_PARAM_ERR;
@@ -888,19 +1734,8 @@ int8_t BME280_ReadAllForce(BME280_t *Dev, BME280_Data_t *Data){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
-
-	/* wait until it ends */
-	Dev->driver->delay(delay);
-
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
-	if(BME280_OK != res) return res;
-
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_all, Dev, &temp, &press, &hum);
+	res = bme280_read_compensate(read_all | read_forced, Dev, &temp, &press, &hum);
 	if(BME280_OK != res) return res;
 
 	/* convert 32bit values to Data structure */
@@ -917,7 +1752,6 @@ int8_t BME280_ReadTempForce(BME280_t *Dev, int8_t *TempInt, uint8_t *TempFract){
 	int8_t res = BME280_OK;
 	BME280_S32_t temp;
 	BME280_Data_t data;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(TempInt) || IS_NULL(TempFract) ) return BME280_PARAM_ERR;
@@ -926,19 +1760,8 @@ int8_t BME280_ReadTempForce(BME280_t *Dev, int8_t *TempInt, uint8_t *TempFract){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
-
-	/* wait until it ends */
-	Dev->driver->delay(delay);
-
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
-	if(BME280_OK != res) return res;
-
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_temp, Dev, &temp, 0, 0);
+	res = bme280_read_compensate(read_temp | read_forced, Dev, &temp, 0, 0);
 	if(BME280_OK != res) return res;
 
 	/* convert 32bit values to local data structure */
@@ -958,7 +1781,6 @@ int8_t BME280_ReadPressForce(BME280_t *Dev, uint16_t *PressInt, uint16_t *PressF
 	BME280_S32_t temp;
 	BME280_U32_t press;
 	BME280_Data_t data;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(PressInt) || IS_NULL(PressFract) ) return BME280_PARAM_ERR;
@@ -967,19 +1789,8 @@ int8_t BME280_ReadPressForce(BME280_t *Dev, uint16_t *PressInt, uint16_t *PressF
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
-
-	/* wait until it ends */
-	Dev->driver->delay(delay);
-
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
-	if(BME280_OK != res) return res;
-
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_press, Dev, &temp, &press, 0);
+	res = bme280_read_compensate(read_press | read_forced, Dev, &temp, &press, 0);
 	if(BME280_OK != res) return res;
 
 	/* convert 32bit value to local data structure */
@@ -999,7 +1810,6 @@ int8_t BME280_ReadHumForce(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract){
 	BME280_S32_t temp;
 	BME280_U32_t hum;
 	BME280_Data_t data;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(HumInt) || IS_NULL(HumFract) ) return BME280_PARAM_ERR;
@@ -1008,19 +1818,8 @@ int8_t BME280_ReadHumForce(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
-
-	/* wait until it ends */
-	Dev->driver->delay(delay);
-
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
-	if(BME280_OK != res) return res;
-
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_hum, Dev, &temp, 0, &hum);
+	res = bme280_read_compensate(read_hum | read_forced, Dev, &temp, 0, &hum);
 	if(BME280_OK != res) return res;
 
 	/* convert 32bit value to local data structure */
@@ -1041,8 +1840,6 @@ int8_t BME280_ReadHumForce(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract){
 int8_t BME280_ReadAllLast_F(BME280_t *Dev, BME280_DataF_t *Data){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	BME280_U32_t press, hum;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Data) ) return BME280_PARAM_ERR;
@@ -1052,13 +1849,7 @@ int8_t BME280_ReadAllLast_F(BME280_t *Dev, BME280_DataF_t *Data){
 	if(BME280_OK != res) return res;
 
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_all, Dev, &temp, &press, &hum);
-	if(BME280_OK != res) return res;
-
-	/* convert 32bit values to Data structure */
-	bme280_convert_t_S32_float(temp, &Data->temp);
-	bme280_convert_p_U32_float(press, &Data->press);
-	bme280_convert_h_U32_float(hum, &Data->hum);
+	res = bme280_read_compensate_float(read_all, Dev, &Data->temp, &Data->press, &Data->hum);
 
 	return res;
 }
@@ -1067,7 +1858,6 @@ int8_t BME280_ReadAllLast_F(BME280_t *Dev, BME280_DataF_t *Data){
 int8_t BME280_ReadTempLast_F(BME280_t *Dev, float *Temp){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Temp) ) return BME280_PARAM_ERR;
@@ -1077,11 +1867,7 @@ int8_t BME280_ReadTempLast_F(BME280_t *Dev, float *Temp){
 	if(BME280_OK != res) return res;
 
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_temp, Dev, &temp, 0, 0);
-	if(BME280_OK != res) return res;
-
-	/* convert 32bit value to external float */
-	bme280_convert_t_S32_float(temp, Temp);
+	res = bme280_read_compensate_float(read_temp, Dev, Temp, 0, 0);
 
 	return res;
 }
@@ -1090,8 +1876,6 @@ int8_t BME280_ReadTempLast_F(BME280_t *Dev, float *Temp){
 int8_t BME280_ReadPressLast_F(BME280_t *Dev, float *Press){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	BME280_U32_t press;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Press) ) return BME280_PARAM_ERR;
@@ -1101,11 +1885,7 @@ int8_t BME280_ReadPressLast_F(BME280_t *Dev, float *Press){
 	if(BME280_OK != res) return res;
 
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_press, Dev, &temp, &press, 0);
-	if(BME280_OK != res) return res;
-
-	/* convert 32bit value to external float */
-	bme280_convert_p_U32_float(press, Press);
+	res = bme280_read_compensate_float(read_press, Dev, 0, Press, 0);
 
 	return res;
 }
@@ -1114,8 +1894,6 @@ int8_t BME280_ReadPressLast_F(BME280_t *Dev, float *Press){
 int8_t BME280_ReadHumLast_F(BME280_t *Dev, float *Hum){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	BME280_U32_t hum;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Hum) ) return BME280_PARAM_ERR;
@@ -1125,11 +1903,7 @@ int8_t BME280_ReadHumLast_F(BME280_t *Dev, float *Hum){
 	if(BME280_OK != res) return res;
 
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_hum, Dev, &temp, 0, &hum);
-	if(BME280_OK != res) return res;
-
-	/* convert 32bit value to external float */
-	bme280_convert_h_U32_float(hum, Hum);
+	res = bme280_read_compensate_float(read_hum, Dev, 0, 0, Hum);
 
 	return res;
 }
@@ -1140,9 +1914,6 @@ int8_t BME280_ReadHumLast_F(BME280_t *Dev, float *Hum){
 int8_t BME280_ReadAllForce_F(BME280_t *Dev, BME280_DataF_t *Data){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	BME280_U32_t press, hum;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Data) ) return BME280_PARAM_ERR;
@@ -1151,22 +1922,8 @@ int8_t BME280_ReadAllForce_F(BME280_t *Dev, BME280_DataF_t *Data){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
-
-	Dev->driver->delay(delay);
-
-	res = bme280_busy_check(Dev);
-	if(BME280_OK != res) return res;
-
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_all, Dev, &temp, &press, &hum);
-	if(BME280_OK != res) return res;
-
-	/* convert 32bit values to Data structure */
-	bme280_convert_t_S32_float(temp, &Data->temp);
-	bme280_convert_p_U32_float(press, &Data->press);
-	bme280_convert_h_U32_float(hum, &Data->hum);
+	res = bme280_read_compensate_float(read_all | read_forced, Dev, &Data->temp, &Data->press, &Data->hum);
 
 	return res;
 }
@@ -1175,8 +1932,6 @@ int8_t BME280_ReadAllForce_F(BME280_t *Dev, BME280_DataF_t *Data){
 int8_t BME280_ReadTempForce_F(BME280_t *Dev, float *Temp){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Temp) ) return BME280_PARAM_ERR;
@@ -1185,23 +1940,8 @@ int8_t BME280_ReadTempForce_F(BME280_t *Dev, float *Temp){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
-
-	/* wait until it ends */
-	Dev->driver->delay(delay);
-
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
-	if(BME280_OK != res) return res;
-
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_temp, Dev, &temp, 0, 0);
-	if(BME280_OK != res) return res;
-
-	/* convert 32bit value to external float */
-	bme280_convert_t_S32_float(temp, Temp);
+	res = bme280_read_compensate_float(read_temp | read_forced, Dev, Temp, 0, 0);
 
 	return res;
 }
@@ -1210,9 +1950,6 @@ int8_t BME280_ReadTempForce_F(BME280_t *Dev, float *Temp){
 int8_t BME280_ReadPressForce_F(BME280_t *Dev, float *Press){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	BME280_U32_t press;
-	uint8_t delay;
 
 	/* check parameters */
 	if( IS_NULL(Dev) || IS_NULL(Press) ) return BME280_PARAM_ERR;
@@ -1221,62 +1958,346 @@ int8_t BME280_ReadPressForce_F(BME280_t *Dev, float *Press){
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
+	/* read the data from sensor */
+	res = bme280_read_compensate_float(read_press | read_forced, Dev, 0, Press, 0);
+
+	return res;
+}
 
-	/* wait until it ends */
-	Dev->driver->delay(delay);
+	/* function forces single measurement and reads the humidity (with floats) */
+int8_t BME280_ReadHumForce_F(BME280_t *Dev, float *Hum){
 
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
+	int8_t res = BME280_OK;
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Hum) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized and in sleep mode */
+	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
 	/* read the data from sensor */
-	res = bme280_read_compensate(read_press, Dev, &temp, &press, 0);
+	res = bme280_read_compensate_float(read_hum | read_forced, Dev, 0, 0, Hum);
+
+	return res;
+}
+#endif
+#endif
+
+#ifdef USE_FIXED_RESULTS
+#ifdef USE_NORMAL_MODE
+	/* function reads last measured values from sensor in normal mode (fixed-point) */
+int8_t BME280_ReadAllLast_Q(BME280_t *Dev, BME280_DataQ_t *Data){
+
+	int8_t res = BME280_OK;
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Data) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized and in normal mode */
+	res = bme280_is_normal_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* convert 32bit value to external float */
-	bme280_convert_p_U32_float(press, Press);
+	/* read the data from sensor directly into Data structure */
+	res = bme280_read_compensate(read_all, Dev, &Data->temp, &Data->press, &Data->hum);
 
 	return res;
 }
+#endif
 
-	/* function forces single measurement and reads the humidity (with floats) */
-int8_t BME280_ReadHumForce_F(BME280_t *Dev, float *Hum){
+#ifdef USE_FORCED_MODE
+	/* function forces single measurement and reads all data (fixed-point) */
+int8_t BME280_ReadAllForce_Q(BME280_t *Dev, BME280_DataQ_t *Data){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t temp;
-	BME280_U32_t hum;
-	uint8_t delay;
 
 	/* check parameters */
-	if( IS_NULL(Dev) || IS_NULL(Hum) ) return BME280_PARAM_ERR;
+	if( IS_NULL(Dev) || IS_NULL(Data) ) return BME280_PARAM_ERR;
 
 	/* check if sensor is initialized and in sleep mode */
 	res = bme280_is_sleep_mode(Dev);
 	if(BME280_OK != res) return res;
 
-	/* force single measure */
-	res = bme280_set_forced_mode(Dev, &delay);
-	if(BME280_OK != res) return res;
+	/* read the data from sensor directly into Data structure */
+	res = bme280_read_compensate(read_all | read_forced, Dev, &Data->temp, &Data->press, &Data->hum);
 
-	/* wait until it ends */
-	Dev->driver->delay(delay);
+	return res;
+}
 
-	/* check if measure is completed */
-	res = bme280_busy_check(Dev);
+	/* function initiates sensor and takes first sample, calibration data are read during conversion */
+int8_t BME280_InitForce_Q(BME280_t *Dev, BME280_Driver_t *Driver, BME280_Config_t *Config, BME280_DataQ_t *Data){
+
+#ifdef USE_LATENCY
+	uint32_t begin = bme280_lat_begin(Driver);
+#endif
+
+	return LATENCY(Driver, BME280_LAT_INIT, begin, bme280_init_force_q(Dev, Driver, Config, Data));
+}
+
+	/* private function to initiate sensor and take first sample, calibration data are read during conversion */
+static int8_t bme280_init_force_q(BME280_t *Dev, BME280_Driver_t *Driver, BME280_Config_t *Config, BME280_DataQ_t *Data){
+
+	int8_t res = BME280_OK;
+	uint8_t ctrl_hum, ctrl_meas, config, delay, status;
+	uint8_t pairs[6];
+
+	/* check parameters and attach the driver to main structure */
+	if( IS_NULL(Config) || IS_NULL(Data) ) return BME280_PARAM_ERR;
+	res = bme280_attach_driver(Dev, Driver);
 	if(BME280_OK != res) return res;
 
-	/* read the data from sensor */
-	res = bme280_read_compensate(read_hum, Dev, &temp, 0, &hum);
+	/* perform sensor reset and check chip ID */
+	res = bme280_reset_check_id(Dev);
+	if(BME280_OK != res) return res;
+
+	/* prepare register values, same as in BME280_ConfigureAll but mode is always forced */
+	bme280_config_to_regs(Config, &ctrl_hum, &ctrl_meas, &config);
+	ctrl_meas &= 0xFC;	//0xFC - 0b11111100
+
+	/* send config and start first conversion, ctrl_meas must be written as last */
+	pairs[0] = BME280_CTRL_HUM_ADDR;
+	pairs[1] = ctrl_hum;
+	pairs[2] = BME280_CONFIG_ADDR;
+	pairs[3] = config;
+	pairs[4] = BME280_CTRL_MEAS_ADDR;
+	pairs[5] = ctrl_meas | BME280_FORCEDMODE;
+	res = bme280_bus_write_burst(Dev, pairs, 3);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+
+	delay = BME280_MEAS_TIME_MS(Config->oversampling_t & 0x07, Config->oversampling_p & 0x07,
+			Config->oversampling_h & 0x07);
+
+	/* read, parse and store compensation data while sensor is measuring */
+	res = bme280_read_compensation_parameters(Dev);
 	if(BME280_OK != res) return res;
 
-	/* convert 32bit value to external float */
-	bme280_convert_h_U32_float(hum, Hum);
+	/* sensor returns to sleep mode by itself after forced measurement */
+	Dev->mode = sleep_mode;
+	Dev->initialized = initialized;
+
+	/* part of measurement time was used by calibration readout, so poll status
+	 * with 1ms steps instead of full delay */
+	while(1){
+
+		res = bme280_bus_read(Dev, BME280_STATUS_ADDR, &status, 1);
+		if(BME280_OK != res) return BME280_INTERFACE_ERR;
+
+		if(0 == (status & 0x09)) break;	// 0x09 - bits "measuring" and "im_update"
+		if(0 == delay) return bme280_busy_err(Dev);
+
+		bme280_bus_delay(Dev, 1);
+		delay--;
+	}
+
+	/* read the data from sensor directly into Data structure */
+	res = bme280_read_compensate(read_all, Dev, &Data->temp, &Data->press, &Data->hum);
 
 	return res;
 }
+#endif
+
+	/* function compensates raw temperature read by user */
+int8_t BME280_CompensateTemp(BME280_t *Dev, BME280_S32_t AdcT, BME280_S32_t *Temp){
+
+#ifdef USE_LATENCY
+	uint32_t begin;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Temp) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+#ifdef USE_LATENCY
+	begin = bme280_lat_begin(Dev->driver);
+#endif
+
+	*Temp = bme280_compensate_t_s32t(Dev, AdcT);
+
+	return LATENCY(Dev->driver, BME280_LAT_COMPENSATE, begin, BME280_OK);
+}
+
+	/* function compensates raw pressure read by user */
+int8_t BME280_CompensatePress(BME280_t *Dev, BME280_S32_t AdcP, BME280_U32_t *Press){
+
+#ifdef USE_LATENCY
+	uint32_t begin;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Press) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+#ifdef USE_LATENCY
+	begin = bme280_lat_begin(Dev->driver);
+#endif
+
+#ifdef USE_PRESS_LUT
+	*Press = bme280_compensate_p_lut(Dev, AdcP);
+#else
+	*Press = bme280_compensate_p_u32t(Dev, AdcP);
+#endif
+
+	return LATENCY(Dev->driver, BME280_LAT_COMPENSATE, begin, BME280_OK);
+}
+
+	/* function compensates raw humidity read by user */
+int8_t BME280_CompensateHum(BME280_t *Dev, BME280_S32_t AdcH, BME280_U32_t *Hum){
+
+#ifdef USE_LATENCY
+	uint32_t begin;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Hum) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+#ifdef USE_LATENCY
+	begin = bme280_lat_begin(Dev->driver);
+#endif
+
+	*Hum = bme280_compensate_h_u32t(Dev, AdcH);
+
+	return LATENCY(Dev->driver, BME280_LAT_COMPENSATE, begin, BME280_OK);
+}
+
+#ifdef USE_INVERSE
+	/* function finds raw temperature for given temperature */
+int8_t BME280_InverseTemp(BME280_t *Dev, BME280_S32_t Temp, BME280_S32_t *AdcT){
+
+#ifdef USE_STATS
+	BME280_Stats_t stats;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(AdcT) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+#ifdef USE_STATS
+	/* compensations of search are not counted */
+	stats = Dev->stats;
+#endif
+
+	*AdcT = bme280_inverse_search(Dev, read_temp, Temp);
+
+	/* leave t_fine of found value */
+	bme280_compensate_t_s32t(Dev, *AdcT);
+
+#ifdef USE_STATS
+	Dev->stats = stats;
+#endif
+
+	return BME280_OK;
+}
+
+	/* function finds raw pressure for given pressure */
+int8_t BME280_InversePress(BME280_t *Dev, BME280_U32_t Press, BME280_S32_t *AdcP){
+
+#ifdef USE_STATS
+	BME280_Stats_t stats;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(AdcP) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+#ifdef USE_STATS
+	/* compensations of search are not counted */
+	stats = Dev->stats;
+#endif
+
+	*AdcP = bme280_inverse_search(Dev, read_press, (BME280_S32_t)Press);
+
+#ifdef USE_STATS
+	Dev->stats = stats;
+#endif
+
+	return BME280_OK;
+}
+
+	/* function finds raw humidity for given humidity */
+int8_t BME280_InverseHum(BME280_t *Dev, BME280_U32_t Hum, BME280_S32_t *AdcH){
+
+#ifdef USE_STATS
+	BME280_Stats_t stats;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(AdcH) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+#ifdef USE_STATS
+	/* compensations of search are not counted */
+	stats = Dev->stats;
+#endif
+
+	*AdcH = bme280_inverse_search(Dev, read_hum, (BME280_S32_t)Hum);
+
+#ifdef USE_STATS
+	Dev->stats = stats;
+#endif
+
+	return BME280_OK;
+}
+
+	/* function synthesizes adc registers for given results */
+int8_t BME280_InverseFrame(BME280_t *Dev, const BME280_DataQ_t *Data, uint8_t *Frame){
+
+	BME280_S32_t adc_T = BME280_PRESS_TEMP_ADC_SKIPPED, adc_P = BME280_PRESS_TEMP_ADC_SKIPPED,
+			adc_H = BME280_HUM_ADC_SKIPPED;
+#ifdef USE_STATS
+	BME280_Stats_t stats;
+#endif
+
+	/* check parameters */
+	if( IS_NULL(Dev) || IS_NULL(Data) || IS_NULL(Frame) ) return BME280_PARAM_ERR;
+
+	/* check if sensor is initialized */
+	if(not_initialized == Dev->initialized) return BME280_NO_INIT_ERR;
+
+#ifdef USE_STATS
+	/* compensations of search are not counted */
+	stats = Dev->stats;
+#endif
+
+	/* pressure and humidity depend on t_fine of found temperature */
+	if(BME280_TEMP_NOT_MEASURED != Data->temp){
+
+		adc_T = bme280_inverse_search(Dev, read_temp, Data->temp);
+		bme280_compensate_t_s32t(Dev, adc_T);
+
+		if(BME280_PRESS_NOT_MEASURED != Data->press){
+
+			adc_P = bme280_inverse_search(Dev, read_press, (BME280_S32_t)Data->press);
+		}
+
+		if(BME280_HUM_NOT_MEASURED != Data->hum) adc_H = bme280_inverse_search(Dev, read_hum, (BME280_S32_t)Data->hum);
+	}
+
+	/* 20-bit values are stored as msb, lsb and upper 4 bits of xlsb */
+	Frame[0] = (uint8_t)(adc_P >> 12);
+	Frame[1] = (uint8_t)(adc_P >> 4);
+	Frame[2] = (uint8_t)(adc_P << 4);
+	Frame[3] = (uint8_t)(adc_T >> 12);
+	Frame[4] = (uint8_t)(adc_T >> 4);
+	Frame[5] = (uint8_t)(adc_T << 4);
+	Frame[6] = (uint8_t)(adc_H >> 8);
+	Frame[7] = (uint8_t)adc_H;
+
+#ifdef USE_STATS
+	Dev->stats = stats;
+#endif
+
+	return BME280_OK;
+}
 #endif
 #endif
 
@@ -1284,101 +2305,831 @@ int8_t BME280_ReadHumForce_F(BME280_t *Dev, float *Hum){
 /* static functions */
 //***************************************
 
-	/* private function to read compensation parameters from sensor and
-	 * parse them inside  BME280_t structure */
-static int8_t bme280_read_compensation_parameters(BME280_t *Dev){
+	/* private function to call user defined read function */
+static int8_t bme280_bus_read(BME280_t *Dev, uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen){
+
+	int8_t res;
+
+	TRACE(Dev, BME280_TRACE_READ, BME280_TRACE_BEGIN, reg_addr);
+#ifdef USE_STATIC_BUS
+	res = bme280_static_read(reg_addr, rxbuff, rxlen, Dev->driver);
+#else
+	res = Dev->driver->read(reg_addr, rxbuff, rxlen, Dev->driver);
+#endif
+	TRACE(Dev, BME280_TRACE_READ, BME280_TRACE_END, reg_addr);
+
+#ifdef USE_STATS
+	bme280_stats_bus(Dev, &Dev->stats.reads, 1U + rxlen, res);
+#endif
+
+	return res;
+}
+
+	/* private function to call user defined write function */
+static int8_t bme280_bus_write(BME280_t *Dev, uint8_t reg_addr, uint8_t value){
+
+	int8_t res;
+
+	TRACE(Dev, BME280_TRACE_WRITE, BME280_TRACE_BEGIN, reg_addr);
+#ifdef USE_STATIC_BUS
+	res = bme280_static_write(reg_addr, value, Dev->driver);
+#else
+	res = Dev->driver->write(reg_addr, value, Dev->driver);
+#endif
+	TRACE(Dev, BME280_TRACE_WRITE, BME280_TRACE_END, reg_addr);
+
+#ifdef USE_STATS
+	bme280_stats_bus(Dev, &Dev->stats.writes, 2U, res);
+#endif
+
+	bme280_cache_update(Dev, reg_addr, value, res);
+
+	return res;
+}
+
+	/* private function to write several registers in single transaction if possible */
+static int8_t bme280_bus_write_burst(BME280_t *Dev, const uint8_t *pairs, uint8_t count){
+
+	int8_t res = BME280_OK;
+	uint8_t i;
+
+#ifndef USE_STATIC_BUS
+	if( !IS_NULL(Dev->driver->write_burst) ){
+
+		TRACE(Dev, BME280_TRACE_WRITE_BURST, BME280_TRACE_BEGIN, count);
+		res = Dev->driver->write_burst(pairs, count, Dev->driver);
+		TRACE(Dev, BME280_TRACE_WRITE_BURST, BME280_TRACE_END, count);
+
+#ifdef USE_STATS
+		bme280_stats_bus(Dev, &Dev->stats.writes, 2U * count, res);
+#endif
+
+		for(i = 0; i < count; i++){
+
+			bme280_cache_update(Dev, pairs[2 * i], pairs[(2 * i) + 1], res);
+		}
+
+		return res;
+	}
+	else if( !IS_NULL(Dev->driver->transfer) && (count <= 4) ){
+
+		/* express pairs as list of write operations */
+		BME280_Op_t ops[4];
+
+		for(i = 0; i < count; i++){
+
+			ops[i].type = BME280_OP_WRITE;
+			ops[i].reg_addr = pairs[2 * i];
+			ops[i].value = pairs[(2 * i) + 1];
+		}
+
+		return bme280_bus_transfer(Dev, ops, count);
+	}
+#endif
+
+	/* write_burst not set, write pairs one by one */
+	for(i = 0; i < count; i++){
+
+		res = bme280_bus_write(Dev, pairs[2 * i], pairs[(2 * i) + 1]);
+		if(BME280_OK != res) break;
+	}
+
+	return res;
+}
+
+	/* function returns number of transactions used to write "count" pairs, the same
+	 * choice as in bme280_bus_write_burst */
+static uint8_t bme280_bus_write_burst_transactions(BME280_t *Dev, uint8_t count){
+
+#ifndef USE_STATIC_BUS
+	if( !IS_NULL(Dev->driver->write_burst) ) return 1;
+	if( !IS_NULL(Dev->driver->transfer) && (count <= 4) ) return 1;
+#else
+	(void)Dev;
+#endif
+
+	return count;
+}
+
+#if !defined(USE_STATIC_BUS) || defined(USE_FORCED_MODE)
+	/* private function to execute list of operations in single transfer if possible */
+static int8_t bme280_bus_transfer(BME280_t *Dev, const BME280_Op_t *ops, uint8_t count){
+
+	int8_t res = BME280_OK;
+	uint8_t i;
+#if defined(USE_STATS) && !defined(USE_STATIC_BUS)
+	uint32_t bytes;
+#endif
+
+#ifndef USE_STATIC_BUS
+	if( !IS_NULL(Dev->driver->transfer) ){
+
+		TRACE(Dev, BME280_TRACE_TRANSFER, BME280_TRACE_BEGIN, count);
+		res = Dev->driver->transfer(ops, count, Dev->driver);
+		TRACE(Dev, BME280_TRACE_TRANSFER, BME280_TRACE_END, count);
+
+#ifdef USE_STATS
+		bytes = 0;
+#endif
+		for(i = 0; i < count; i++){
+
+			if(BME280_OP_WRITE == ops[i].type) bme280_cache_update(Dev, ops[i].reg_addr, ops[i].value, res);
+#ifdef USE_STATS
+			if(BME280_OP_WRITE == ops[i].type) bytes += 2U;
+			else if(BME280_OP_READ == ops[i].type) bytes += 1U + ops[i].len;
+			else Dev->stats.delay_ms += ops[i].value;
+#endif
+		}
+#ifdef USE_STATS
+		bme280_stats_bus(Dev, &Dev->stats.transfers, bytes, res);
+#endif
+
+		return res;
+	}
+#endif
+
+	/* transfer not set, execute operations one by one */
+	for(i = 0; i < count; i++){
+
+		switch(ops[i].type){
+
+		case BME280_OP_WRITE:
+			res = bme280_bus_write(Dev, ops[i].reg_addr, ops[i].value);
+			break;
+
+		case BME280_OP_READ:
+			res = bme280_bus_read(Dev, ops[i].reg_addr, ops[i].rxbuff, ops[i].len);
+			break;
+
+		case BME280_OP_DELAY:
+			bme280_bus_delay(Dev, ops[i].value);
+			break;
+
+		default:
+			return BME280_PARAM_ERR;
+			break;
+		}
+		if(BME280_OK != res) break;
+	}
+
+	return res;
+}
+#endif
+
+	/* private function to update copy of control registers */
+static void bme280_cache_update(BME280_t *Dev, uint8_t reg_addr, uint8_t value, int8_t res){
+
+	/* state of registers is unknown after failure */
+	if(BME280_OK != res){
+
+		Dev->regs.valid = 0;
+	}
+	else if(BME280_CTRL_HUM_ADDR == reg_addr){
+
+		Dev->regs.ctrl_hum = value;
+	}
+	else if(BME280_CTRL_MEAS_ADDR == reg_addr){
+
+		/* forced measurement ends in sleep mode */
+		Dev->regs.ctrl_meas = (normal_mode == (value & 0x03)) ? value : (uint8_t)(value & 0xFC);
+	}
+	else if(BME280_CONFIG_ADDR == reg_addr){
+
+		Dev->regs.config = value;
+	}
+	else if(BME280_RESET_ADDR == reg_addr){
+
+		/* all control registers are cleared by reset */
+		Dev->regs.ctrl_hum = 0;
+		Dev->regs.ctrl_meas = 0;
+		Dev->regs.config = 0;
+		Dev->regs.valid = 1;
+	}
+}
+
+	/* private function to call user defined delay function */
+static void bme280_bus_delay(BME280_t *Dev, uint8_t delay_time){
+
+#ifdef USE_STATS
+	Dev->stats.delay_ms += delay_time;
+#endif
+
+	TRACE(Dev, BME280_TRACE_WAIT, BME280_TRACE_BEGIN, delay_time);
+#ifdef USE_STATIC_BUS
+	(void)Dev;
+	bme280_static_delay(delay_time);
+#else
+	Dev->driver->delay(delay_time);
+#endif
+	TRACE(Dev, BME280_TRACE_WAIT, BME280_TRACE_END, delay_time);
+}
+
+#ifdef USE_STATS
+	/* private function to count bus transaction */
+static void bme280_stats_bus(BME280_t *Dev, uint32_t *counter, uint32_t bytes, int8_t res){
+
+	(*counter)++;
+	Dev->stats.bytes += bytes;
+	if(BME280_OK != res) Dev->stats.interface_errors++;
+}
+#endif
+
+	/* private function to return (and count) busy result */
+static int8_t bme280_busy_err(BME280_t *Dev){
+
+#ifdef USE_STATS
+	Dev->stats.busy_errors++;
+#else
+	(void)Dev;
+#endif
+
+	return BME280_BUSY_ERR;
+}
+
+#ifdef USE_TRACE
+	/* private function to call user defined trace function */
+static void bme280_trace_event(BME280_t *Dev, uint8_t event, uint8_t edge, uint8_t arg){
+
+	if( !IS_NULL(Dev->driver->trace) ) Dev->driver->trace(event, edge, arg, Dev->driver);
+}
+#endif
+
+#ifdef USE_LATENCY
+	/* private function to read time at start of operation */
+static uint32_t bme280_lat_begin(BME280_Driver_t *Driver){
+
+	if( IS_NULL(Driver) || IS_NULL(Driver->clock) ) return 0;
+
+	return Driver->clock();
+}
+
+	/* private function to record latency of operation */
+static int8_t bme280_lat_end(BME280_Driver_t *Driver, uint8_t op, uint32_t begin, int8_t res){
+
+	BME280_Hist_t *hist;
+	uint32_t elapsed;
+
+	if( IS_NULL(Driver) || IS_NULL(Driver->clock) || IS_NULL(Driver->latency) ) return res;
+
+	/* unsigned difference is valid also when clock wraps around */
+	elapsed = Driver->clock() - begin;
+
+	hist = &Driver->latency->op[op];
+	hist->count[bme280_lat_bucket(elapsed)]++;
+	hist->total++;
+	if(elapsed > hist->max) hist->max = elapsed;
+
+	return res;
+}
+
+	/* private function to find bucket of value */
+static uint16_t bme280_lat_bucket(uint32_t value){
+
+	uint8_t msb = BME280_LAT_SUB_BITS;
+
+	/* small values have own buckets */
+	if(value < (1UL << BME280_LAT_SUB_BITS)) return (uint16_t)value;
+
+	/* values out of range are counted in last bucket */
+	if(value >= (1UL << BME280_LAT_MAX_BITS)) return BME280_LAT_BUCKETS - 1;
+
+	/* find most significant bit, then take BME280_LAT_SUB_BITS bits below it */
+	while(value >= (2UL << msb)) msb++;
+
+	return (uint16_t)(((msb - BME280_LAT_SUB_BITS + 1) << BME280_LAT_SUB_BITS) +
+			(value >> (msb - BME280_LAT_SUB_BITS)) - (1UL << BME280_LAT_SUB_BITS));
+}
+
+	/* private function to calculate upper bound of bucket */
+static uint32_t bme280_lat_bucket_top(uint16_t idx){
+
+	uint16_t octave = idx >> BME280_LAT_SUB_BITS;
+	uint32_t sub = idx & ((1U << BME280_LAT_SUB_BITS) - 1);
+
+	if(0 == octave) return idx;
+
+	/* first value of next bucket minus one */
+	return (((sub + 1 + (1UL << BME280_LAT_SUB_BITS)) << (octave - 1)) - 1);
+}
+#endif
+
+	/* private function to read compensation parameters from sensor and
+	 * parse them inside  BME280_t structure */
+static int8_t bme280_read_compensation_parameters(BME280_t *Dev){
+
+	uint8_t tmp_buff[32];
+	int8_t res;
+
+	/* read two calibration data's areas from sensor */
+	res = bme280_bus_read(Dev, BME280_CALIB_DATA1_ADDR, &tmp_buff[0], BME280_CALIB_DATA1_LEN);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	res = bme280_bus_read(Dev, BME280_CALIB_DATA2_ADDR, &tmp_buff[25], BME280_CALIB_DATA2_LEN);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+
+	/* parse data to the structure inside Dev */
+	bme280_parse_compensation_parameters(Dev, tmp_buff);
+
+	return BME280_OK;
+}
+
+	/* private function to parse compensation parameters inside BME280_t structure */
+static void bme280_parse_compensation_parameters(BME280_t *Dev, const uint8_t *tmp_buff){
+
+	Dev->trimm.dig_T1 = CAT_UI16T(tmp_buff[1], tmp_buff[0]);
+	Dev->trimm.dig_T2 = CAT_I16T(tmp_buff[3], tmp_buff[2]);
+	Dev->trimm.dig_T3 = CAT_I16T(tmp_buff[5], tmp_buff[4]);
+
+	Dev->trimm.dig_P1 = CAT_UI16T(tmp_buff[7], tmp_buff[6]);
+	Dev->trimm.dig_P2 = CAT_I16T(tmp_buff[9], tmp_buff[8]);
+	Dev->trimm.dig_P3 = CAT_I16T(tmp_buff[11], tmp_buff[10]);
+	Dev->trimm.dig_P4 = CAT_I16T(tmp_buff[13], tmp_buff[12]);
+	Dev->trimm.dig_P5 = CAT_I16T(tmp_buff[15], tmp_buff[14]);
+	Dev->trimm.dig_P6 = CAT_I16T(tmp_buff[17], tmp_buff[16]);
+	Dev->trimm.dig_P7 = CAT_I16T(tmp_buff[19], tmp_buff[18]);
+	Dev->trimm.dig_P8 = CAT_I16T(tmp_buff[21], tmp_buff[20]);
+	Dev->trimm.dig_P9 = CAT_I16T(tmp_buff[23], tmp_buff[22]);
+
+	Dev->trimm.dig_H1 = tmp_buff[24];
+	Dev->trimm.dig_H2 = CAT_I16T(tmp_buff[26], tmp_buff[25]);
+	Dev->trimm.dig_H3 = tmp_buff[27];
+						/*       	MSB              				LSB			       */
+	Dev->trimm.dig_H4 = ( ((int16_t)tmp_buff[28] << 4) | ((int16_t)tmp_buff[29] & 0x0F) );
+
+						/*       	MSB              				LSB			       */
+	Dev->trimm.dig_H5 = ( ((int16_t)tmp_buff[30] << 4) | ((int16_t)tmp_buff[29] >> 4) );
+	Dev->trimm.dig_H6 = (int8_t)tmp_buff[31];
+
+#ifdef USE_FLOAT_COMPENSATION
+	/* prepare coefficients for floating point compensation */
+	bme280_prepare_float_calibration(Dev);
+#endif
+
+#ifdef USE_TFINE_MEMO
+	/* terms calculated with previous calibration data are not valid anymore */
+	Dev->memo.valid = 0;
+#endif
+
+#ifdef USE_PRESS_LUT
+	/* knots calculated with previous calibration data are not valid anymore */
+	memset(Dev->p_lut.valid, 0, sizeof(Dev->p_lut.valid));
+#endif
+
+#ifdef USE_INVERSE
+	/* slopes of previous calibration data are not valid anymore */
+	memset(&Dev->inverse, 0, sizeof(Dev->inverse));
+#endif
+}
+
+	/* private function to check parameters and attach the driver to main structure */
+static int8_t bme280_attach_driver(BME280_t *Dev, BME280_Driver_t *Driver){
+
+	/* check parameters */
+#ifdef USE_STATIC_BUS
+	if( IS_NULL(Dev) || IS_NULL(Driver) ) return BME280_PARAM_ERR;
+#else
+	if( IS_NULL(Dev) || IS_NULL(Driver) || IS_NULL(Driver->write) || IS_NULL(Driver->read) ||
+			IS_NULL(Driver->delay) ) return BME280_PARAM_ERR;
+#endif
+
+	/* attach the driver to main structure, state of registers is not known yet */
+	Dev->driver = Driver;
+	Dev->regs.valid = 0;
+#ifdef USE_STATS
+	memset(&Dev->stats, 0, sizeof(Dev->stats));
+#endif
+#ifdef USE_TEMP_REUSE
+	Dev->t_reuse.period = 0;
+	Dev->t_reuse.left = 0;
+	Dev->t_reuse.valid = 0;
+#endif
+
+	return BME280_OK;
+}
+
+	/* private function to convert configuration into register values */
+static void bme280_config_to_regs(const BME280_Config_t *Config, uint8_t *ctrl_hum, uint8_t *ctrl_meas,
+		uint8_t *config){
+
+	/* set the data from Config structure to the right positions in
+	 * sensor registers */
+	*ctrl_hum = Config->oversampling_h & 0x07;	//0x07 - 0b00000111
+
+	*ctrl_meas = (Config->oversampling_t << 5) & 0xE0; 	//0xE0 - 0b11100000
+	*ctrl_meas |= (Config->oversampling_p << 2) & 0x1C;	//0x1C - 0b00011100
+	*ctrl_meas |= Config->mode & 0x03;					//0x03 - 0b00000011
+
+	*config = (Config->t_stby << 5) & 0xE0;	//0xE0 - 0b11100000
+	*config |= (Config->filter << 2) & 0x1C;	//0x1C - 0b00011100
+	*config |= Config->spi3w_enable & 0x01;	//0x01 - 0b00000001
+}
+
+	/* private function to read control registers into cache */
+static int8_t bme280_read_regs_cache(BME280_t *Dev, uint8_t *buff){
+
+	int8_t res = BME280_OK;
+
+	/* read ctrl_hum, status, ctrl_meas and config registers */
+	res = bme280_bus_read(Dev, BME280_CTRL_HUM_ADDR, buff, 4);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+
+	Dev->regs.ctrl_hum = buff[0];
+	Dev->regs.ctrl_meas = (normal_mode == (buff[2] & 0x03)) ? buff[2] : (uint8_t)(buff[2] & 0xFC);
+	Dev->regs.config = buff[3];
+	Dev->regs.valid = 1;
+
+	return res;
+}
+
+	/* private function to reset sensor and check its ID */
+static int8_t bme280_reset_check_id(BME280_t *Dev){
+
+	int8_t res = BME280_OK;
+
+	/* perform sensor reset */
+	res = BME280_Reset(Dev);
+	if(BME280_OK != res) return res;
+
+	/* Start-up time = 2ms */
+	bme280_bus_delay(Dev, 2);
+
+	/* read and check chip ID */
+	return bme280_check_id(Dev);
+}
+
+	/* private function to read and check chip ID */
+static int8_t bme280_check_id(BME280_t *Dev){
+
+	int8_t res = BME280_OK;
+	uint8_t id = 0;
+
+	res = bme280_bus_read(Dev, BME280_ID_ADDR, &id, 1);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+
+	if(BME280_ID != id) return BME280_ID_ERR;
+
+	return res;
+}
+
+#ifdef USE_CALIB_BLOB
+	/* calculates CRC-8, polynomial 0x31, init value 0xFF */
+static uint8_t bme280_crc8(const uint8_t *buff, uint8_t len){
+
+	uint8_t crc = 0xFF;
+	uint8_t i;
+
+	while(len--){
+
+		crc ^= *buff++;
+		for(i = 0; i < 8; i++){
+
+			crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+	/* function compares part of calibration data read from sensor with blob */
+static int8_t bme280_check_calib(BME280_t *Dev, const uint8_t *Blob){
+
+	uint8_t buff[2];
+	int8_t res;
+
+	/* dig_T1, first bytes of first block */
+	res = bme280_bus_read(Dev, BME280_CALIB_DATA1_ADDR, buff, 2);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	if( (buff[0] != Blob[0]) || (buff[1] != Blob[1]) ) return BME280_CALIB_ERR;
+
+	/* dig_H2, first bytes of second block */
+	res = bme280_bus_read(Dev, BME280_CALIB_DATA2_ADDR, buff, 2);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	if( (buff[0] != Blob[BME280_CALIB_DATA1_LEN]) || (buff[1] != Blob[BME280_CALIB_DATA1_LEN + 1]) ){
+
+		return BME280_CALIB_ERR;
+	}
+
+	return BME280_OK;
+}
+#endif
+
+	/* private function to narrow range of adc registers to measured channels */
+static void bme280_adc_range(BME280_t *Dev, uint8_t *reg_addr, uint8_t *rxlen){
+
+	uint8_t first = BME280_TEMP_ADC_ADDR, last = BME280_TEMP_ADC_ADDR + BME280_TEMP_ADC_LEN;
+
+	/* osrs_p bits in ctrl_meas (0x1C = 0b00011100), osrs_h bits in ctrl_hum (0x07 = 0b00000111) */
+	if(BME280_OVERSAMPLING_SKIPP != ((Dev->regs.ctrl_meas >> 2) & 0x07)) first = BME280_PRESS_ADC_ADDR;
+	if(BME280_OVERSAMPLING_SKIPP != (Dev->regs.ctrl_hum & 0x07)) last = BME280_HUM_ADC_ADDR + BME280_HUM_ADC_LEN;
+
+	*reg_addr = first;
+	*rxlen = last - first;
+}
+
+	/* private function to find channels disabled with BME280_OVERSAMPLING_SKIPP */
+static int8_t bme280_skipped(BME280_t *Dev, uint8_t *skipped){
+
+	int8_t res = BME280_OK;
+	uint8_t buff[4];
+
+	/* state of control registers is unknown, read it once */
+	if(0 == Dev->regs.valid){
+
+		res = bme280_read_regs_cache(Dev, buff);
+		if(BME280_OK != res) return res;
+	}
+
+	/* osrs_t and osrs_p bits in ctrl_meas (0xE0, 0x1C), osrs_h bits in ctrl_hum (0x07) */
+	*skipped = 0;
+	if(BME280_OVERSAMPLING_SKIPP == ((Dev->regs.ctrl_meas >> 5) & 0x07)) *skipped |= BME280_SKIPPED_TEMP;
+	if(BME280_OVERSAMPLING_SKIPP == ((Dev->regs.ctrl_meas >> 2) & 0x07)) *skipped |= BME280_SKIPPED_PRESS;
+	if(BME280_OVERSAMPLING_SKIPP == (Dev->regs.ctrl_hum & 0x07)) *skipped |= BME280_SKIPPED_HUM;
+
+	return res;
+}
+
+#ifdef USE_TEMP_REUSE
+	/* private function to update temperature reuse state after t_fine refresh */
+static void bme280_temp_reuse_update(BME280_t *Dev, BME280_S32_t temp){
+
+	BME280_S32_t delta = temp - Dev->t_reuse.temp;
+
+	if(delta < 0) delta = -delta;
+
+	/* reuse t_fine only if temperature is stable between two refreshes */
+	if( (0 != Dev->t_reuse.valid) && (delta <= (BME280_S32_t)Dev->t_reuse.max_delta) ){
+
+		Dev->t_reuse.left = Dev->t_reuse.period;
+	}
+	else{
+
+		Dev->t_reuse.left = 0;
+	}
+
+	Dev->t_reuse.temp = temp;
+	Dev->t_reuse.valid = 1;
+}
+#endif
+
+	/* private function to read and compensate selected adc
+	 * data from sensor, latency of all reads is recorded here */
+static int8_t bme280_read_compensate(uint8_t read_type, BME280_t *Dev, BME280_S32_t *temp,
+		BME280_U32_t *press, BME280_U32_t *hum){
+
+#ifdef USE_LATENCY
+	uint32_t begin = bme280_lat_begin(Dev->driver);
+	uint8_t op = (read_type & read_forced) ? BME280_LAT_READ_FORCED : BME280_LAT_READ_LAST;
+#endif
+
+	return LATENCY(Dev->driver, op, begin, bme280_read_compensate_q(read_type, Dev, temp, press, hum));
+}
+
+	/* private function to read and compensate selected adc
+	 * data from sensor as integers */
+static int8_t bme280_read_compensate_q(uint8_t read_type, BME280_t *Dev, BME280_S32_t *temp,
+		BME280_U32_t *press, BME280_U32_t *hum){
+
+	int8_t res = BME280_OK;
+	BME280_S32_t adc_T = 0, adc_P = 0, adc_H = 0;
+	uint8_t skipped = 0;
+
+#ifdef USE_TEMP_REUSE
+	/* read pressure only if t_fine can be reused */
+	if( (read_press == (read_type & read_type_mask)) && (0 != Dev->t_reuse.left) ){
+
+		read_type = (read_type & read_forced) | read_press_only;
+	}
+#endif
+
+	/* read selected adc data from sensor */
+	res = bme280_read_adc(read_type, Dev, &adc_T, &adc_P, &adc_H, &skipped);
+	if(BME280_OK != res) return res;
+	read_type &= read_type_mask;
+
+	/* compensate data, skipped measurements are marked as not measured */
+	TRACE(Dev, BME280_TRACE_COMPENSATE, BME280_TRACE_BEGIN, 0);
+#ifdef USE_TEMP_REUSE
+	if(read_press_only == read_type){
+
+		/* temperature of cached t_fine */
+		*temp = (Dev->t_fine * 5 + 128) / 256;
+		Dev->t_reuse.left--;
+	}
+	else
+#endif
+	if(skipped & BME280_SKIPPED_TEMP){
+
+		/* pressure and humidity cannot be compensated without temperature */
+		*temp = BME280_TEMP_NOT_MEASURED;
+		skipped |= BME280_SKIPPED_PRESS | BME280_SKIPPED_HUM;
+	}
+	else{
+
+		*temp = bme280_compensate_t_s32t(Dev, adc_T);
+#ifdef USE_TEMP_REUSE
+		bme280_temp_reuse_update(Dev, *temp);
+#endif
+	}
+
+	if((read_press == read_type) || (read_press_only == read_type) || (read_all == read_type)){
+
+#ifdef USE_PRESS_LUT
+		*press = (skipped & BME280_SKIPPED_PRESS) ? BME280_PRESS_NOT_MEASURED :
+				bme280_compensate_p_lut(Dev, adc_P);
+#else
+		*press = (skipped & BME280_SKIPPED_PRESS) ? BME280_PRESS_NOT_MEASURED :
+				bme280_compensate_p_u32t(Dev, adc_P);
+#endif
+	}
+
+	if((read_hum == read_type) || (read_all == read_type)){
+
+		*hum = (skipped & BME280_SKIPPED_HUM) ? BME280_HUM_NOT_MEASURED :
+				bme280_compensate_h_u32t(Dev, adc_H);
+	}
+	TRACE(Dev, BME280_TRACE_COMPENSATE, BME280_TRACE_END, 0);
+
+#ifdef USE_STATS
+	Dev->stats.samples++;
+#endif
+
+	return res;
+}
+
+#ifdef USE_FLOATS_RESULTS
+#ifdef USE_FLOAT_COMPENSATION
+	/* private function to read and compensate selected adc
+	 * data from sensor with floats */
+static int8_t bme280_read_compensate_f(uint8_t read_type, BME280_t *Dev, float *temp,
+		float *press, float *hum){
+
+	int8_t res = BME280_OK;
+	BME280_S32_t adc_T = 0, adc_P = 0, adc_H = 0;
+	uint8_t skipped = 0;
+	float t;
+
+	/* read selected adc data from sensor */
+	res = bme280_read_adc(read_type, Dev, &adc_T, &adc_P, &adc_H, &skipped);
+	if(BME280_OK != res) return res;
+	read_type &= read_type_mask;
+
+	/* compensate data, temperature is always required to calculate t_fine_f */
+	TRACE(Dev, BME280_TRACE_COMPENSATE, BME280_TRACE_BEGIN, 0);
+	if(skipped & BME280_SKIPPED_TEMP){
+
+		/* pressure and humidity cannot be compensated without temperature */
+		t = NAN;
+		skipped |= BME280_SKIPPED_PRESS | BME280_SKIPPED_HUM;
+	}
+	else{
+
+		t = bme280_compensate_t_float(Dev, adc_T);
+	}
+	if(!IS_NULL(temp)) *temp = t;
+
+	if((read_press == read_type) || (read_all == read_type)){
+
+		/* Pa -> hPa */
+		*press = (skipped & BME280_SKIPPED_PRESS) ? NAN : bme280_compensate_p_float(Dev, adc_P) * 0.01F;
+	}
+
+	if((read_hum == read_type) || (read_all == read_type)){
+
+		*hum = (skipped & BME280_SKIPPED_HUM) ? NAN : bme280_compensate_h_float(Dev, adc_H);
+	}
+	TRACE(Dev, BME280_TRACE_COMPENSATE, BME280_TRACE_END, 0);
+
+#ifdef USE_STATS
+	Dev->stats.samples++;
+#endif
+
+	return res;
+}
+#endif
+
+	/* private function to read and compensate selected adc
+	 * data from sensor as floats */
+static int8_t bme280_read_compensate_float(uint8_t read_type, BME280_t *Dev, float *temp,
+		float *press, float *hum){
+
+	int8_t res = BME280_OK;
+
+#ifdef USE_FLOAT_COMPENSATION
+#ifdef USE_LATENCY
+	uint32_t begin = bme280_lat_begin(Dev->driver);
+	uint8_t op = (read_type & read_forced) ? BME280_LAT_READ_FORCED : BME280_LAT_READ_LAST;
+#endif
 
-	uint8_t tmp_buff[32];
-	int8_t res;
+	/* read and compensate the data with floats */
+	res = LATENCY(Dev->driver, op, begin, bme280_read_compensate_f(read_type, Dev, temp, press, hum));
+#else
+	BME280_S32_t t;
+	BME280_U32_t p, h;
 
-	/* read two calibration data's areas from sensor */
-	res = Dev->driver->read(BME280_CALIB_DATA1_ADDR, &tmp_buff[0], BME280_CALIB_DATA1_LEN,
-			Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
-	res = Dev->driver->read(BME280_CALIB_DATA2_ADDR, &tmp_buff[25], BME280_CALIB_DATA2_LEN,
-			Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	/* read and compensate the data with integers */
+	res = bme280_read_compensate(read_type, Dev, &t, &p, &h);
+	if(BME280_OK != res) return res;
+	read_type &= read_type_mask;
 
-	// parse data to the structure inside Dev
-	Dev->trimm.dig_T1 = CAT_UI16T(tmp_buff[1], tmp_buff[0]);
-	Dev->trimm.dig_T2 = CAT_I16T(tmp_buff[3], tmp_buff[2]);
-	Dev->trimm.dig_T3 = CAT_I16T(tmp_buff[5], tmp_buff[4]);
+	/* convert 32bit values to floats */
+	if(!IS_NULL(temp)) bme280_convert_t_S32_float(t, temp);
 
-	Dev->trimm.dig_P1 = CAT_UI16T(tmp_buff[7], tmp_buff[6]);
-	Dev->trimm.dig_P2 = CAT_I16T(tmp_buff[9], tmp_buff[8]);
-	Dev->trimm.dig_P3 = CAT_I16T(tmp_buff[11], tmp_buff[10]);
-	Dev->trimm.dig_P4 = CAT_I16T(tmp_buff[13], tmp_buff[12]);
-	Dev->trimm.dig_P5 = CAT_I16T(tmp_buff[15], tmp_buff[14]);
-	Dev->trimm.dig_P6 = CAT_I16T(tmp_buff[17], tmp_buff[16]);
-	Dev->trimm.dig_P7 = CAT_I16T(tmp_buff[19], tmp_buff[18]);
-	Dev->trimm.dig_P8 = CAT_I16T(tmp_buff[21], tmp_buff[20]);
-	Dev->trimm.dig_P9 = CAT_I16T(tmp_buff[23], tmp_buff[22]);
+	if((read_press == read_type) || (read_all == read_type)){
 
-	Dev->trimm.dig_H1 = tmp_buff[24];
-	Dev->trimm.dig_H2 = CAT_I16T(tmp_buff[26], tmp_buff[25]);
-	Dev->trimm.dig_H3 = tmp_buff[27];
-						/*       	MSB              				LSB			       */
-	Dev->trimm.dig_H4 = ( ((int16_t)tmp_buff[28] << 4) | ((int16_t)tmp_buff[29] & 0x0F) );
+		bme280_convert_p_U32_float(p, press);
+	}
 
-						/*       	MSB              				LSB			       */
-	Dev->trimm.dig_H5 = ( ((int16_t)tmp_buff[30] << 4) | ((int16_t)tmp_buff[29] >> 4) );
-	Dev->trimm.dig_H6 = (int8_t)tmp_buff[31];
+	if((read_hum == read_type) || (read_all == read_type)){
 
-	return BME280_OK;
+		bme280_convert_h_U32_float(h, hum);
+	}
+#endif
+
+	return res;
 }
+#endif
 
-	/* private function to read and compensate selected adc
-	 * data from sensor  */
-static int8_t bme280_read_compensate(uint8_t read_type, BME280_t *Dev, BME280_S32_t *temp,
-		BME280_U32_t *press, BME280_U32_t *hum){
+	/* private function to read selected adc data from sensor and parse
+	 * them into single variables */
+static int8_t bme280_read_adc(uint8_t read_type, BME280_t *Dev, BME280_S32_t *adc_T,
+		BME280_S32_t *adc_P, BME280_S32_t *adc_H, uint8_t *skipped){
 
 	int8_t res = BME280_OK;
-	BME280_S32_t adc_T, adc_P, adc_H;
 	struct adc_regs adc_raw;
+	uint8_t reg_addr, rxlen, *rxbuff;
 
-	/* read selected adc data from sensor */
-	switch(read_type){
+	/* select range of adc registers */
+	switch(read_type & read_type_mask){
 
 	case read_temp:
-		res = Dev->driver->read(BME280_TEMP_ADC_ADDR, (uint8_t *)&adc_raw.temp_raw, BME280_TEMP_ADC_LEN,
-				Dev->driver);
+		reg_addr = BME280_TEMP_ADC_ADDR;
+		rxbuff = (uint8_t *)&adc_raw.temp_raw;
+		rxlen = BME280_TEMP_ADC_LEN;
 		break;
 
 	case read_press:
-		res = Dev->driver->read(BME280_PRESS_ADC_ADDR, (uint8_t *)&adc_raw.press_raw, (BME280_PRESS_ADC_LEN +
-				BME280_TEMP_ADC_LEN), Dev->driver);
+		reg_addr = BME280_PRESS_ADC_ADDR;
+		rxbuff = (uint8_t *)&adc_raw.press_raw;
+		rxlen = BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN;
+		break;
+
+	case read_press_only:
+		reg_addr = BME280_PRESS_ADC_ADDR;
+		rxbuff = (uint8_t *)&adc_raw.press_raw;
+		rxlen = BME280_PRESS_ADC_LEN;
 		break;
 
 	case read_hum:
-		res = Dev->driver->read(BME280_TEMP_ADC_ADDR, (uint8_t *)&adc_raw.temp_raw, (BME280_TEMP_ADC_LEN +
-				BME280_HUM_ADC_LEN), Dev->driver);
+		reg_addr = BME280_TEMP_ADC_ADDR;
+		rxbuff = (uint8_t *)&adc_raw.temp_raw;
+		rxlen = BME280_TEMP_ADC_LEN + BME280_HUM_ADC_LEN;
 		break;
 
 	case read_all:
-		res = Dev->driver->read(BME280_PRESS_ADC_ADDR, (uint8_t *)&adc_raw.press_raw, (BME280_PRESS_ADC_LEN +
-				BME280_TEMP_ADC_LEN + BME280_HUM_ADC_LEN), Dev->driver);
+		reg_addr = BME280_PRESS_ADC_ADDR;
+		rxlen = BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN + BME280_HUM_ADC_LEN;
+		/* skip disabled channels if configuration is known */
+		if(0 != Dev->regs.valid) bme280_adc_range(Dev, &reg_addr, &rxlen);
+		rxbuff = (uint8_t *)&adc_raw + (reg_addr - BME280_PRESS_ADC_ADDR);
 		break;
 
 	default:
 		return BME280_PARAM_ERR;
 		break;
 	}
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
-	/* parse  and compensate data from adc_raw structure to variables */
-	adc_T = bme280_parse_press_temp_s32t((uint8_t *)&adc_raw.temp_raw);
-	*temp = bme280_compensate_t_s32t(Dev, adc_T);
+	/* read selected adc data from sensor, force measurement before if requested */
+#ifdef USE_FORCED_MODE
+	if(read_type & read_forced){
+
+		res = bme280_forced_read(Dev, reg_addr, rxbuff, rxlen);
+		if(BME280_OK != res) return res;
+	}
+	else
+#endif
+	{
+		TRACE(Dev, BME280_TRACE_BURST_READ, BME280_TRACE_BEGIN, rxlen);
+		res = bme280_bus_read(Dev, reg_addr, rxbuff, rxlen);
+		TRACE(Dev, BME280_TRACE_BURST_READ, BME280_TRACE_END, rxlen);
+		if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	}
+	read_type &= read_type_mask;
 
-	if((read_press == read_type) || (read_all == read_type)){
+	/* find skipped channels, cache is valid here after forced measurement */
+	res = bme280_skipped(Dev, skipped);
+	if(BME280_OK != res) return res;
 
-		adc_P = bme280_parse_press_temp_s32t((uint8_t *)&adc_raw.press_raw);
-		*press = bme280_compensate_p_u32t(Dev, adc_P);
+	/* parse data from adc_raw structure to variables, skipped channels may be out of read range */
+	if(read_press_only != read_type) *adc_T = bme280_parse_press_temp_s32t((uint8_t *)&adc_raw.temp_raw);
+
+	if( ((read_press == read_type) || (read_press_only == read_type) || (read_all == read_type)) &&
+			(0 == (*skipped & BME280_SKIPPED_PRESS)) ){
+
+		*adc_P = bme280_parse_press_temp_s32t((uint8_t *)&adc_raw.press_raw);
 	}
 
-	if((read_hum == read_type) || (read_all == read_type)){
+	if( ((read_hum == read_type) || (read_all == read_type)) && (0 == (*skipped & BME280_SKIPPED_HUM)) ){
 
-		adc_H = bme280_parse_hum_s32t((uint8_t *)&adc_raw.hum_raw);
-		*hum = bme280_compensate_h_u32t(Dev, adc_H);
+		*adc_H = bme280_parse_hum_s32t((uint8_t *)&adc_raw.hum_raw);
 	}
 
 	return res;
@@ -1416,6 +3167,10 @@ static BME280_S32_t bme280_compensate_t_s32t(BME280_t *Dev, BME280_S32_t adc_T){
 	BME280_S32_t var2;
 	BME280_S32_t temperature;
 
+#ifdef USE_STATS
+	Dev->stats.comp_temp++;
+#endif
+
     var1 = (BME280_S32_t)((adc_T / 8) - ((BME280_S32_t)Dev->trimm.dig_T1 * 2));
     var1 = (var1 * ((BME280_S32_t)Dev->trimm.dig_T2)) / 2048;
     var2 = (BME280_S32_t)((adc_T / 16) - ((BME280_S32_t)Dev->trimm.dig_T1));
@@ -1438,6 +3193,20 @@ static BME280_U32_t bme280_compensate_p_u32t(BME280_t *Dev, BME280_S32_t adc_P){
 	BME280_S64_t var4;
 	BME280_U32_t pressure;
 
+#ifdef USE_STATS
+	Dev->stats.comp_press++;
+#endif
+
+#ifdef USE_TFINE_MEMO
+	/* terms depending on t_fine only are calculated once per t_fine */
+	if( (0 != (Dev->memo.valid & memo_press)) && (Dev->memo.t_fine_p == Dev->t_fine) ){
+
+		var1 = Dev->memo.p_var1;
+		var2 = Dev->memo.p_var2;
+	}
+	else
+#endif
+	{
     var1 = ((BME280_S64_t)Dev->t_fine) - 128000;
     var2 = var1 * var1 * (BME280_S64_t)Dev->trimm.dig_P6;
     var2 = var2 + ((var1 * (BME280_S64_t)Dev->trimm.dig_P5) * 131072);
@@ -1445,7 +3214,24 @@ static BME280_U32_t bme280_compensate_p_u32t(BME280_t *Dev, BME280_S32_t adc_P){
     var1 = ((var1 * var1 * (BME280_S64_t)Dev->trimm.dig_P3) / 256) + ((var1 * ((BME280_S64_t)Dev->trimm.dig_P2) * 4096));
     var3 = ((BME280_S64_t)1) * 140737488355328;
     var1 = (var3 + var1) * ((BME280_S64_t)Dev->trimm.dig_P1) / 8589934592;
+#ifdef USE_TFINE_MEMO
+    Dev->memo.p_var1 = var1;
+    Dev->memo.p_var2 = var2;
+    Dev->memo.t_fine_p = Dev->t_fine;
+    Dev->memo.valid |= memo_press;
+#endif
+	}
 
+#ifdef USE_CONST_TIME
+    /* divide by 1 instead of 0 and mask the result, var3 - all ones if var1 != 0 */
+    var3 = (var1 | -var1) >> 63;
+    var4 = 1048576 - adc_P;
+    var4 = bme280_div_s64_ct(((var4 * INT64_C(2147483648)) - var2) * 3125, var1 | (~var3 & 1));
+    var1 = (((BME280_S64_t)Dev->trimm.dig_P9) * (var4 / 8192) * (var4 / 8192)) / 33554432;
+    var2 = (((BME280_S64_t)Dev->trimm.dig_P8) * var4) / 524288;
+    var4 = ((var4 + var1 + var2) / 256) + (((BME280_S64_t)Dev->trimm.dig_P7) * 16);
+    pressure = (BME280_U32_t)(((var4 / 2) * 100) / 128) & (BME280_U32_t)var3;
+#else
     /* To avoid divide by zero exception */
     if (var1 != 0)
     {
@@ -1461,11 +3247,29 @@ static BME280_U32_t bme280_compensate_p_u32t(BME280_t *Dev, BME280_S32_t adc_P){
     {
         pressure = 0;
     }
+#endif
 
 #else
 	BME280_S32_t var1, var2;
 	BME280_U32_t pressure;
+#ifdef USE_CONST_TIME
+	BME280_U32_t valid, quot, rem;
+#endif
+
+#ifdef USE_STATS
+	Dev->stats.comp_press++;
+#endif
+
+#ifdef USE_TFINE_MEMO
+	/* terms depending on t_fine only are calculated once per t_fine */
+	if( (0 != (Dev->memo.valid & memo_press)) && (Dev->memo.t_fine_p == Dev->t_fine) ){
 
+		var1 = Dev->memo.p_var1;
+		var2 = Dev->memo.p_var2;
+	}
+	else
+#endif
+	{
 	var1 = (((BME280_S32_t)Dev->t_fine)>>1) - (BME280_S32_t)64000;
 	var2 = (((var1>>2) * (var1>>2)) >> 11 ) * ((BME280_S32_t)Dev->trimm.dig_P6);
 	var2 = var2 + ((var1*((BME280_S32_t)Dev->trimm.dig_P5))<<1);
@@ -1473,6 +3277,24 @@ static BME280_U32_t bme280_compensate_p_u32t(BME280_t *Dev, BME280_S32_t adc_P){
 	var1 = (((Dev->trimm.dig_P3 * (((var1>>2) * (var1>>2)) >> 13 )) >> 3) + ((((BME280_S32_t)Dev->trimm.dig_P2) *
 	var1)>>1))>>18;
 	var1 =((((32768+var1))*((BME280_S32_t)Dev->trimm.dig_P1))>>15);
+#ifdef USE_TFINE_MEMO
+	Dev->memo.p_var1 = var1;
+	Dev->memo.p_var2 = var2;
+	Dev->memo.t_fine_p = Dev->t_fine;
+	Dev->memo.valid |= memo_press;
+#endif
+	}
+#ifdef USE_CONST_TIME
+	/* divide by 1 instead of 0 and mask the result, valid - all ones if var1 != 0 */
+	valid = (BME280_U32_t)((var1 | -var1) >> 31);
+	pressure = (((BME280_U32_t)(((BME280_S32_t)1048576)-adc_P)-(var2>>12)))*3125;
+	/* (pressure << 1) / var1 for pressure < 0x80000000, (pressure / var1) * 2 otherwise */
+	quot = bme280_div_u32_ct(pressure, (BME280_U32_t)var1 | (~valid & 1), &rem);
+	pressure = (quot << 1) + ((~pressure >> 31) & (BME280_U32_t)((rem << 1) >= (BME280_U32_t)var1));
+	var1 = (((BME280_S32_t)Dev->trimm.dig_P9) * ((BME280_S32_t)(((pressure>>3) * (pressure>>3))>>13)))>>12;
+	var2 = (((BME280_S32_t)(pressure>>2)) * ((BME280_S32_t)Dev->trimm.dig_P8))>>13;
+	pressure = (BME280_U32_t)((BME280_S32_t)pressure + ((var1 + var2 + Dev->trimm.dig_P7) >> 4)) & valid;
+#else
 	if (var1 == 0)
 	{
 	return 0; // avoid exception caused by division by zero
@@ -1489,11 +3311,124 @@ static BME280_U32_t bme280_compensate_p_u32t(BME280_t *Dev, BME280_S32_t adc_P){
 	var1 = (((BME280_S32_t)Dev->trimm.dig_P9) * ((BME280_S32_t)(((pressure>>3) * (pressure>>3))>>13)))>>12;
 	var2 = (((BME280_S32_t)(pressure>>2)) * ((BME280_S32_t)Dev->trimm.dig_P8))>>13;
 	pressure = (BME280_U32_t)((BME280_S32_t)pressure + ((var1 + var2 + Dev->trimm.dig_P7) >> 4));
+#endif
 #endif
 
     return pressure;
 }
 
+#ifdef USE_CONST_TIME
+#ifdef USE_64BIT
+	/* Returns num / den truncated toward zero, restoring division with fixed
+	 * number of iterations, signs are handled with masks */
+static BME280_S64_t bme280_div_s64_ct(BME280_S64_t num, BME280_S64_t den){
+
+	uint64_t sn = (uint64_t)(num >> 63), sd = (uint64_t)(den >> 63);
+	uint64_t n = ((uint64_t)num ^ sn) - sn, d = ((uint64_t)den ^ sd) - sd;
+	uint64_t q = 0, r = 0, m;
+	int8_t i;
+
+	for(i = 63; i >= 0; i--){
+
+		r = (r << 1) | ((n >> i) & 1U);
+		m = (uint64_t)0 - (uint64_t)(r >= d);
+		r -= d & m;
+		q |= (m & 1U) << i;
+	}
+
+	/* negate quotient if signs differ */
+	sn ^= sd;
+
+	return (BME280_S64_t)((q ^ sn) - sn);
+}
+#else
+	/* Returns num / den, restoring division with fixed number of iterations */
+static BME280_U32_t bme280_div_u32_ct(BME280_U32_t num, BME280_U32_t den, BME280_U32_t *rem){
+
+	BME280_U32_t q = 0, r = 0, m;
+	int8_t i;
+
+	for(i = 31; i >= 0; i--){
+
+		r = (r << 1) | ((num >> i) & 1U);
+		m = (BME280_U32_t)0 - (BME280_U32_t)(r >= den);
+		r -= den & m;
+		q |= (m & 1U) << i;
+	}
+
+	*rem = r;
+
+	return q;
+}
+#endif
+#endif
+
+#ifdef USE_PRESS_LUT
+	/* Returns pressure like bme280_compensate_p_u32t, interpolated between knots
+	 * compensated for two t_fine values around current t_fine */
+static BME280_U32_t bme280_compensate_p_lut(BME280_t *Dev, BME280_S32_t adc_P){
+
+	BME280_S32_t offset = adc_P - BME280_PRESS_LUT_FIRST, dt = Dev->t_fine - Dev->p_lut.t_fine, diff;
+	BME280_U32_t p0;
+	uint16_t idx;
+
+	/* values out of table are compensated with full formula */
+	if( (adc_P < BME280_PRESS_LUT_FIRST) || (adc_P >= BME280_PRESS_LUT_LAST) ) return bme280_compensate_p_u32t(Dev, adc_P);
+
+	/* t_fine is more than half of window away from both sets, center new window at t_fine */
+	if( (dt < -((BME280_S32_t)1 << (BME280_PRESS_LUT_TSHIFT - 1))) ||
+			(dt > ((BME280_S32_t)3 << (BME280_PRESS_LUT_TSHIFT - 1))) ){
+
+		memset(Dev->p_lut.valid, 0, sizeof(Dev->p_lut.valid));
+		Dev->p_lut.t_fine = Dev->t_fine - ((BME280_S32_t)1 << (BME280_PRESS_LUT_TSHIFT - 1));
+		dt = (BME280_S32_t)1 << (BME280_PRESS_LUT_TSHIFT - 1);
+	}
+
+	idx = (uint16_t)(offset >> BME280_PRESS_LUT_SHIFT);
+	offset &= ((BME280_S32_t)1 << BME280_PRESS_LUT_SHIFT) - 1;
+
+	/* interpolate in adc_P within both sets, then in t_fine between them */
+	p0 = bme280_press_lut_interp(Dev, 0, idx, offset);
+	diff = (BME280_S32_t)(bme280_press_lut_interp(Dev, 1, idx, offset) - p0);
+
+	return p0 + (BME280_U32_t)((diff * dt) >> BME280_PRESS_LUT_TSHIFT);
+}
+
+	/* Returns pressure interpolated between two knots of single set */
+static BME280_U32_t bme280_press_lut_interp(BME280_t *Dev, uint8_t set, uint16_t idx, BME280_S32_t offset){
+
+	BME280_S32_t diff;
+
+	/* pressure falls with adc_P, so difference is negative */
+	diff = (BME280_S32_t)(bme280_press_lut_knot(Dev, set, idx + 1) - bme280_press_lut_knot(Dev, set, idx));
+
+#ifdef USE_64BIT
+	return Dev->p_lut.knots[set][idx] + (BME280_U32_t)(((BME280_S64_t)diff * offset) >> BME280_PRESS_LUT_SHIFT);
+#else
+	return Dev->p_lut.knots[set][idx] + (BME280_U32_t)((diff * offset) >> BME280_PRESS_LUT_SHIFT);
+#endif
+}
+
+	/* Returns knot of pressure table, compensates it first if needed */
+static BME280_U32_t bme280_press_lut_knot(BME280_t *Dev, uint8_t set, uint16_t idx){
+
+	BME280_S32_t t_fine;
+
+	if(0 == (Dev->p_lut.valid[set][idx / 32] & ((uint32_t)1 << (idx % 32)))){
+
+		/* compensate knot for t_fine of its set */
+		t_fine = Dev->t_fine;
+		Dev->t_fine = Dev->p_lut.t_fine + ((BME280_S32_t)set << BME280_PRESS_LUT_TSHIFT);
+		Dev->p_lut.knots[set][idx] = bme280_compensate_p_u32t(Dev,
+				BME280_PRESS_LUT_FIRST + ((BME280_S32_t)idx << BME280_PRESS_LUT_SHIFT));
+		Dev->t_fine = t_fine;
+		Dev->p_lut.valid[set][idx / 32] |= ((uint32_t)1 << (idx % 32));
+	}
+
+	return Dev->p_lut.knots[set][idx];
+}
+#endif
+
 	/* Returns humidity in %RH as unsigned 32bit integer in Q22.10 format (22 integer
 	 * and 10 fractional bits). Output value of "47445" represents 47445/1024 = 46.333 %RH */
 static BME280_U32_t bme280_compensate_h_u32t(BME280_t *Dev, BME280_S32_t adc_H){
@@ -1505,38 +3440,319 @@ static BME280_U32_t bme280_compensate_h_u32t(BME280_t *Dev, BME280_S32_t adc_H){
 	BME280_S32_t var5;
 	BME280_U32_t humidity;
 
+#ifdef USE_STATS
+	Dev->stats.comp_hum++;
+#endif
+
+#ifdef USE_TFINE_MEMO
+	/* terms depending on t_fine only are calculated once per t_fine */
+	if( (0 != (Dev->memo.valid & memo_hum)) && (Dev->memo.t_fine_h == Dev->t_fine) ){
+
+		var4 = Dev->memo.h_var4;
+		var1 = Dev->memo.h_var2;
+	}
+	else
+#endif
+	{
     var1 = Dev->t_fine - ((BME280_S32_t)76800);
-    var2 = (BME280_S32_t)(adc_H * 16384);
-    var3 = (BME280_S32_t)(((BME280_S32_t)Dev->trimm.dig_H4) * 1048576);
     var4 = ((BME280_S32_t)Dev->trimm.dig_H5) * var1;
-    var5 = (((var2 - var3) - var4) + (BME280_S32_t)16384) / 32768;
     var2 = (var1 * ((BME280_S32_t)Dev->trimm.dig_H6)) / 1024;
     var3 = (var1 * ((BME280_S32_t)Dev->trimm.dig_H3)) / 2048;
-    var4 = ((var2 * (var3 + (BME280_S32_t)32768)) / 1024) + (BME280_S32_t)2097152;
-    var2 = ((var4 * ((BME280_S32_t)Dev->trimm.dig_H2)) + 8192) / 16384;
-    var3 = var5 * var2;
+    var1 = ((var2 * (var3 + (BME280_S32_t)32768)) / 1024) + (BME280_S32_t)2097152;
+    var1 = ((var1 * ((BME280_S32_t)Dev->trimm.dig_H2)) + 8192) / 16384;
+#ifdef USE_TFINE_MEMO
+    Dev->memo.h_var4 = var4;
+    Dev->memo.h_var2 = var1;
+    Dev->memo.t_fine_h = Dev->t_fine;
+    Dev->memo.valid |= memo_hum;
+#endif
+	}
+
+    /* adc dependent part, var4 - dig_H5 term, var1 - dig_H6, dig_H3 and dig_H2 terms */
+    var2 = (BME280_S32_t)(adc_H * 16384);
+    var3 = (BME280_S32_t)(((BME280_S32_t)Dev->trimm.dig_H4) * 1048576);
+    var5 = (((var2 - var3) - var4) + (BME280_S32_t)16384) / 32768;
+    var3 = var5 * var1;
     var4 = ((var3 / 32768) * (var3 / 32768)) / 128;
     var5 = var3 - ((var4 * ((BME280_S32_t)Dev->trimm.dig_H1)) / 16);
+#ifdef USE_CONST_TIME
+    /* clamp to 0..419430400 with masks */
+    var5 = var5 & ~(var5 >> 31);
+    var4 = (BME280_S32_t)419430400 - var5;
+    var5 = var5 + (var4 & (var4 >> 31));
+#else
     var5 = (var5 < 0 ? 0 : var5);
     var5 = (var5 > 419430400 ? 419430400 : var5);
+#endif
     humidity = (BME280_U32_t)(var5 / 4096);
 
     return humidity;
 }
 
+#if defined(USE_INVERSE) && defined(USE_FIXED_RESULTS)
+	/* function compensates single channel */
+static BME280_S32_t bme280_inverse_eval(BME280_t *Dev, uint8_t channel, BME280_S32_t adc){
+
+	switch(channel){
+
+	case read_temp:
+		return bme280_compensate_t_s32t(Dev, adc);
+
+	case read_press:
+#ifdef USE_PRESS_LUT
+		return (BME280_S32_t)bme280_compensate_p_lut(Dev, adc);
+#else
+		return (BME280_S32_t)bme280_compensate_p_u32t(Dev, adc);
+#endif
+
+	default:
+		return (BME280_S32_t)bme280_compensate_h_u32t(Dev, adc);
+	}
+}
+
+	/* function finds adc value of channel */
+static BME280_S32_t bme280_inverse_search(BME280_t *Dev, uint8_t channel, BME280_S32_t target){
+
+	struct BME280_inverse_state *st = &Dev->inverse;
+	BME280_S32_t lo = 0, hi, flo, fhi, x, fx, step, sign;
+	uint8_t idx = channel - read_temp;
+	float dist;
+
+	/* range of adc values */
+	if(read_hum == channel) hi = 0xFFFF;
+	else hi = (read_press == channel) ? INVERSE_PRESS_ADC_MAX : 0xFFFFF;
+
+	if(0.0F == st->slope[idx]){
+
+		/* first search, slope of whole range */
+		flo = bme280_inverse_eval(Dev, channel, lo);
+		fhi = bme280_inverse_eval(Dev, channel, hi);
+		if(fhi == flo) return lo;
+		st->slope[idx] = (float)(hi - lo) / (float)(fhi - flo);
+	}
+	else{
+
+		/* step from last value by expected distance (and a bit more), double it until target is passed */
+		x = st->adc[idx];
+		fx = bme280_inverse_eval(Dev, channel, x);
+		dist = (float)(target - fx) * st->slope[idx];
+		step = (BME280_S32_t)dist;
+		step += (step / 16) + ((dist < 0.0F) ? -1 : 1);
+		lo = x;
+		flo = fx;
+
+		while(fx != target){
+
+			lo = x + step;
+			if(lo < 0) lo = 0;
+			if(lo > hi) lo = hi;
+
+			flo = bme280_inverse_eval(Dev, channel, lo);
+			if( ((flo - target) * (BME280_S32_t)((fx > target) - (fx < target)) <= 0) || (lo == x) ) break;
+
+			x = lo;
+			fx = flo;
+			step *= 2;
+		}
+
+		/* bracket between last two points */
+		hi = x;
+		fhi = fx;
+	}
+
+	/* search on rising function, pressure falls when adc value rises */
+	if(hi < lo){
+
+		x = lo; lo = hi; hi = x;
+		x = flo; flo = fhi; fhi = x;
+	}
+	sign = (fhi < flo) ? -1 : 1;
+
+	/* out of range, nearest end */
+	if((sign * target) <= (sign * flo)) x = lo;
+	else if((sign * target) >= (sign * fhi)) x = hi;
+	else x = bme280_inverse_refine(Dev, channel, sign, sign * target, lo, sign * flo, hi, sign * fhi);
+
+	st->adc[idx] = x;
+
+	return x;
+}
+
+	/* function finds adc value inside bracket */
+static BME280_S32_t bme280_inverse_refine(BME280_t *Dev, uint8_t channel, BME280_S32_t sign, BME280_S32_t target,
+		BME280_S32_t lo, BME280_S32_t flo, BME280_S32_t hi, BME280_S32_t fhi){
+
+	BME280_S32_t x, fx;
+	int8_t side = 0;
+	float rlo = (float)(flo - target), rhi = (float)(fhi - target);
+
+	/* residuals of ends are used to interpolate next point */
+	while((hi - lo) > 1){
+
+		x = lo + (BME280_S32_t)((rlo * (float)(hi - lo)) / (rlo - rhi));
+		if(x <= lo) x = lo + 1;
+		if(x >= hi) x = hi - 1;
+
+		fx = sign * bme280_inverse_eval(Dev, channel, x);
+		if(fx == target) return x;
+
+		if(fx < target){
+
+			lo = x;
+			flo = fx;
+			rlo = (float)(fx - target);
+
+			/* the same end kept twice, halve its residual so it moves next time */
+			if(side < 0) rhi /= 2.0F;
+			side = -1;
+		}
+		else{
+
+			hi = x;
+			fhi = fx;
+			rhi = (float)(fx - target);
+
+			if(side > 0) rlo /= 2.0F;
+			side = 1;
+		}
+	}
+
+	/* the nearest end */
+	return ((target - flo) < (fhi - target)) ? lo : hi;
+}
+#endif
+
+#ifdef USE_FLOAT_COMPENSATION
+	/* private function that folds constant divisors of floating point formulas into
+	 * calibration data, so compensation needs multiplications and a single division only */
+static void bme280_prepare_float_calibration(BME280_t *Dev){
+
+	struct BME280_float_calibration *f = &Dev->trimm_f;
+
+	f->t1_1024 = (float)Dev->trimm.dig_T1 / 1024.0F;
+	f->t1_8192 = (float)Dev->trimm.dig_T1 / 8192.0F;
+	f->t2 = (float)Dev->trimm.dig_T2;
+	f->t3 = (float)Dev->trimm.dig_T3;
+
+	f->p1 = (float)Dev->trimm.dig_P1;
+	f->p1_32768 = (float)Dev->trimm.dig_P1 / 32768.0F;
+	f->p2 = (float)Dev->trimm.dig_P2 / 524288.0F;
+	f->p3 = ((float)Dev->trimm.dig_P3 / 524288.0F) / 524288.0F;
+	f->p4 = (float)Dev->trimm.dig_P4 * 65536.0F;
+	f->p5 = (float)Dev->trimm.dig_P5 * 2.0F;
+	f->p6 = (float)Dev->trimm.dig_P6 / 32768.0F;
+	f->p7 = (float)Dev->trimm.dig_P7 / 16.0F;
+	f->p8 = (float)Dev->trimm.dig_P8 / 524288.0F;
+	f->p9 = (float)Dev->trimm.dig_P9 / 34359738368.0F;
+
+	f->h1 = (float)Dev->trimm.dig_H1 / 524288.0F;
+	f->h2 = (float)Dev->trimm.dig_H2 / 65536.0F;
+	f->h3 = (float)Dev->trimm.dig_H3 / 67108864.0F;
+	f->h4 = (float)Dev->trimm.dig_H4 * 64.0F;
+	f->h5 = (float)Dev->trimm.dig_H5 / 16384.0F;
+	f->h6 = (float)Dev->trimm.dig_H6 / 67108864.0F;
+}
+
+	/* Returns temperature in DegC as float (datasheet floating point formula).
+	 * t_fine_f carries fine temperature as global value. Result matches
+	 * integer formula within 0.02 DegC (integer result is rounded to 0.01 DegC) */
+static float bme280_compensate_t_float(BME280_t *Dev, BME280_S32_t adc_T){
+
+	float var1;
+	float var2;
+
+#ifdef USE_STATS
+	Dev->stats.comp_temp++;
+#endif
+
+	var1 = ((float)adc_T * (1.0F / 16384.0F)) - Dev->trimm_f.t1_1024;
+	var1 = var1 * Dev->trimm_f.t2;
+	var2 = ((float)adc_T * (1.0F / 131072.0F)) - Dev->trimm_f.t1_8192;
+	var2 = (var2 * var2) * Dev->trimm_f.t3;
+	Dev->t_fine_f = var1 + var2;
+
+	return Dev->t_fine_f * (1.0F / 5120.0F);
+}
+
+	/* Returns pressure in Pa as float (datasheet floating point formula).
+	 * Result matches 64-bit integer formula within 0.1 Pa (0.001 hPa) */
+static float bme280_compensate_p_float(BME280_t *Dev, BME280_S32_t adc_P){
+
+	float var1;
+	float var2;
+	float pressure;
+
+#ifdef USE_STATS
+	Dev->stats.comp_press++;
+#endif
+
+	var1 = (Dev->t_fine_f * 0.5F) - 64000.0F;
+	var2 = var1 * var1 * Dev->trimm_f.p6;
+	var2 = var2 + (var1 * Dev->trimm_f.p5);
+	var2 = (var2 * 0.25F) + Dev->trimm_f.p4;
+	var1 = (Dev->trimm_f.p3 * var1 * var1) + (Dev->trimm_f.p2 * var1);
+	var1 = Dev->trimm_f.p1 + (var1 * Dev->trimm_f.p1_32768);
+
+	/* avoid exception caused by division by zero */
+	if(0.0F == var1) return 0.0F;
+
+	pressure = 1048576.0F - (float)adc_P;
+	pressure = ((pressure - (var2 * (1.0F / 4096.0F))) * 6250.0F) / var1;
+	var1 = Dev->trimm_f.p9 * pressure * pressure;
+	var2 = Dev->trimm_f.p8 * pressure;
+	pressure = pressure + var1 + var2 + Dev->trimm_f.p7;
+
+	return pressure;
+}
+
+	/* Returns humidity in %RH as float (datasheet floating point formula).
+	 * Result matches integer formula within 0.01 %RH */
+static float bme280_compensate_h_float(BME280_t *Dev, BME280_S32_t adc_H){
+
+	float var_h;
+
+#ifdef USE_STATS
+	Dev->stats.comp_hum++;
+#endif
+
+	var_h = Dev->t_fine_f - 76800.0F;
+	var_h = ((float)adc_H - (Dev->trimm_f.h4 + (Dev->trimm_f.h5 * var_h))) *
+			(Dev->trimm_f.h2 * (1.0F + (Dev->trimm_f.h6 * var_h * (1.0F + (Dev->trimm_f.h3 * var_h)))));
+	var_h = var_h * (1.0F - (Dev->trimm_f.h1 * var_h));
+
+	if(var_h > 100.0F) var_h = 100.0F;
+	else if(var_h < 0.0F) var_h = 0.0F;
+
+	return var_h;
+}
+#endif
+
 #ifdef USE_INTEGER_RESULTS
 	/* function converts BME280_S32_t temperature to BME280_Data_t structure */
 static void bme280_convert_t_S32_struct(BME280_S32_t temp, BME280_Data_t *data){
 
+	if(BME280_TEMP_NOT_MEASURED == temp){
+
+		data->temp_int = BME280_TEMP_INT_NOT_MEASURED;
+		data->temp_fract = 0;
+		return;
+	}
+
 	data->temp_int = (BME280_S32_t)temp / 100;
 	data->temp_fract = (BME280_S32_t)temp % 100;
 }
 #endif
 
-#ifdef USE_FLOATS_RESULTS
+#if defined(USE_FLOATS_RESULTS) && !defined(USE_FLOAT_COMPENSATION)
 	/* function converts BME280_S32_t temperature to float */
 static void bme280_convert_t_S32_float(BME280_S32_t temp_in, float *temp_out){
 
+	if(BME280_TEMP_NOT_MEASURED == temp_in){
+
+		*temp_out = NAN;
+		return;
+	}
+
 	*temp_out= (float)temp_in / 100.0F;
 }
 #endif
@@ -1545,6 +3761,13 @@ static void bme280_convert_t_S32_float(BME280_S32_t temp_in, float *temp_out){
 	/* function converts BME280_U32_t pressure to BME280_Data_t structure */
 static void bme280_convert_p_U32_struct(BME280_U32_t press, BME280_Data_t *data){
 
+	if(BME280_PRESS_NOT_MEASURED == press){
+
+		data->pressure_int = BME280_PRESS_INT_NOT_MEASURED;
+		data->pressure_fract = 0;
+		return;
+	}
+
 #ifdef USE_64BIT
 	data->pressure_int = press / (BME280_U32_t)10000;
 	data->pressure_fract = (press % (BME280_U32_t)10000) / (BME280_U32_t)10;
@@ -1555,10 +3778,16 @@ static void bme280_convert_p_U32_struct(BME280_U32_t press, BME280_Data_t *data)
 }
 #endif
 
-#ifdef USE_FLOATS_RESULTS
+#if defined(USE_FLOATS_RESULTS) && !defined(USE_FLOAT_COMPENSATION)
 	/* function converts BME280_U32_t pressure to float */
 static void bme280_convert_p_U32_float(BME280_U32_t press_in, float *press_out){
 
+	if(BME280_PRESS_NOT_MEASURED == press_in){
+
+		*press_out = NAN;
+		return;
+	}
+
 #ifdef USE_64BIT
 	*press_out = (float)press_in / 10000.0F;
 #else
@@ -1571,16 +3800,30 @@ static void bme280_convert_p_U32_float(BME280_U32_t press_in, float *press_out){
 	/* function converts BME280_U32_t humidity to BME280_Data_t structure */
 static void bme280_convert_h_U32_struct(BME280_U32_t hum, BME280_Data_t *data){
 
-	data->humidity_int = hum / (BME280_U32_t)1000;
-	data->humidity_fract = hum % (BME280_U32_t)1000;
+	if(BME280_HUM_NOT_MEASURED == hum){
+
+		data->humidity_int = BME280_HUM_INT_NOT_MEASURED;
+		data->humidity_fract = 0;
+		return;
+	}
+
+	/* humidity is in Q22.10 format, fractional part is scaled to 3 decimal digits */
+	data->humidity_int = hum >> 10;
+	data->humidity_fract = ((hum & (BME280_U32_t)0x3FF) * (BME280_U32_t)1000) >> 10;
 }
 #endif
 
-#ifdef USE_FLOATS_RESULTS
+#if defined(USE_FLOATS_RESULTS) && !defined(USE_FLOAT_COMPENSATION)
 	/* function converts BME280_U32_t humidity to float */
 static void bme280_convert_h_U32_float(BME280_U32_t hum_in, float *hum_out){
 
-	*hum_out = (float)hum_in / 1000.0F;
+	if(BME280_HUM_NOT_MEASURED == hum_in){
+
+		*hum_out = NAN;
+		return;
+	}
+
+	*hum_out = (float)hum_in / 1024.0F;
 }
 #endif
 
@@ -1607,69 +3850,79 @@ static int8_t bme280_is_sleep_mode(BME280_t *Dev){
 }
 
 #ifdef USE_FORCED_MODE
-	/* function checks and sets forced mode if possible + calculates delay */
-static int8_t bme280_set_forced_mode(BME280_t *Dev, uint8_t *delay){
+	/* function forces single measurement and reads adc data as single list of operations */
+static int8_t bme280_forced_read(BME280_t *Dev, uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen){
 
 	int8_t res = BME280_OK;
-	uint8_t buff[3];
-	uint8_t mode, osrs_t, osrs_p, osrs_h;
-
-	/* read ctrl_hum, status and ctrl_meas registers */
-	res = Dev->driver->read(BME280_CTRL_HUM_ADDR, buff, 3, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	uint8_t ctrl[3] = { 0 }, delay;
+	BME280_Op_t ops[4];
 
-	/* check if sensor is not busy */
-	buff[1] &= 0x09; // mask bits "measuring" - bit 0 and "im_update" - bit 3 only (0x09 = 0b00001001)
-	if(0 != buff[1]) return BME280_BUSY_ERR;
-
-	/* check if sensor is in sleep mode */
-	mode = buff[2] & 0x03;
-	if(BME280_SLEEPMODE != mode) return BME280_CONDITION_ERR;
+	/* check conditions and calculate delay */
+	TRACE(Dev, BME280_TRACE_BUSY_CHECK, BME280_TRACE_BEGIN, 0);
+	res = bme280_forced_check(Dev, &delay);
+	TRACE(Dev, BME280_TRACE_BUSY_CHECK, BME280_TRACE_END, 0);
+	if(BME280_OK != res) return res;
 
-	/* parse oversampling values from ctrl_meas */
-	osrs_p = (buff[2] >> 2) & 0x07;
-	osrs_t = (buff[2] >> 5) & 0x07;
-	osrs_h = buff[0] & 0x07;
+	/* set forced mode */
+	ops[0].type = BME280_OP_WRITE;
+	ops[0].reg_addr = BME280_CTRL_MEAS_ADDR;
+	ops[0].value = (Dev->regs.ctrl_meas & 0xFC) | BME280_FORCEDMODE;	//0xFC - 0b11111100
+
+	/* wait max. measurement time calculated from oversampling values */
+	ops[1].type = BME280_OP_DELAY;
+	ops[1].value = delay;
+
+	/* read ctrl_hum, status and ctrl_meas registers (in the same transaction as status alone), then adc data */
+	ops[2].type = BME280_OP_READ;
+	ops[2].reg_addr = BME280_CTRL_HUM_ADDR;
+	ops[2].rxbuff = ctrl;
+	ops[2].len = 3;
+
+	ops[3].type = BME280_OP_READ;
+	ops[3].reg_addr = reg_addr;
+	ops[3].rxbuff = rxbuff;
+	ops[3].len = rxlen;
+
+	TRACE(Dev, BME280_TRACE_TRIGGER, BME280_TRACE_BEGIN, delay);
+	res = bme280_bus_transfer(Dev, ops, 4);
+	TRACE(Dev, BME280_TRACE_TRIGGER, BME280_TRACE_END, delay);
+	if(BME280_OK != res) return BME280_INTERFACE_ERR;
 
-	/* covert osrs_x reg values into oversampling values */
-	bme280_osrs_to_oversampling(&osrs_p);
-	bme280_osrs_to_oversampling(&osrs_t);
-	bme280_osrs_to_oversampling(&osrs_h);
+	/* oversampling values differ from cache (f.e. sensor was reset after brown-out), so adc data are not valid */
+	if( ((ctrl[0] & 0x07) != (Dev->regs.ctrl_hum & 0x07)) || ((ctrl[2] & 0xFC) != (Dev->regs.ctrl_meas & 0xFC)) ){
 
-	/* calculate delay */
-	*delay = ((125U + (230U * osrs_t) + ((230U * osrs_p) + 58U) + ((230U * osrs_h) + 58U)) / 100U) + 1U;
+		Dev->regs.valid = 0;
+		return BME280_STATE_ERR;
+	}
 
-	/* set forced mode */
-	buff[2] &= 0xFC;	///0xFC - 0b11111100
-	buff[2] |= BME280_FORCEDMODE;
-	res = Dev->driver->write(BME280_CTRL_MEAS_ADDR, buff[2], Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+	/* check if measure is completed */
+	if(0 != (ctrl[1] & 0x09)) return bme280_busy_err(Dev); // mask bits "measuring" - bit 0 and "im_update" - bit 3 only (0x09 = 0b00001001)
 
 	return res;
 }
 
-	/* convers osrs_x register value to oversampling value */
-static void bme280_osrs_to_oversampling(uint8_t *osrs){
+	/* function checks conditions of forced measurement and calculates delay */
+static int8_t bme280_forced_check(BME280_t *Dev, uint8_t *delay){
 
-	if(*osrs <= BME280_OVERSAMPLING_X2) return;				// here reg value = ovs value, no need to change
-	else if(BME280_OVERSAMPLING_X4 == *osrs) *osrs = 4U;	// set ovs = 4
-	else if(BME280_OVERSAMPLING_X8 == *osrs) *osrs = 8U;	// set ovs = 8
-	else *osrs = 16U;										// any other case set ovs max = 16
-}
+	int8_t res = BME280_OK;
+	uint8_t buff[4];
 
-	/* checks sensor's status */
-static int8_t bme280_busy_check(BME280_t *Dev){
+	/* state of control registers is unknown, read it once */
+	if(0 == Dev->regs.valid){
 
-	int8_t res = BME280_OK;
-	uint8_t status;
+		res = bme280_read_regs_cache(Dev, buff);
+		if(BME280_OK != res) return res;
 
-	/* read status register */
-	res = Dev->driver->read(BME280_STATUS_ADDR, &status, 1, Dev->driver);
-	if(BME280_OK != res) return BME280_INTERFACE_ERR;
+		/* check if sensor is not busy */
+		if(0 != (buff[1] & 0x09)) return bme280_busy_err(Dev); // mask bits "measuring" and "im_update" (0x09 = 0b00001001)
+	}
+
+	/* check if sensor is in sleep mode */
+	if(BME280_SLEEPMODE != (Dev->regs.ctrl_meas & 0x03)) return BME280_CONDITION_ERR;
 
-	/* check if both bits are not set */
-	status &= 0x09; // mask bits "measuring" - bit 0 and "im_update" - bit 3 only (0x09 = 0b00001001)
-	if(0 != status) return BME280_BUSY_ERR;
+	/* calculate max. measurement time from oversampling values */
+	*delay = BME280_MEAS_TIME_MS((Dev->regs.ctrl_meas >> 5) & 0x07, (Dev->regs.ctrl_meas >> 2) & 0x07,
+			Dev->regs.ctrl_hum & 0x07);
 
 	return res;
 }
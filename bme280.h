@@ -26,8 +26,6 @@ extern "C" {
 
 //***************************************
 
-#include "bme280_definitions.h"
-
 /**
  * @defgroup BME280_libconf Library Configuration
  * @brief Set library options here
@@ -39,6 +37,10 @@ extern "C" {
 #define USE_FLOATS_RESULTS
 /// comment this line if you don't need to use functions with integer results
 #define USE_INTEGER_RESULTS
+/// comment this line if you don't need to use functions with native fixed-point results (BME280_ReadAllxxx_Q)
+#define USE_FIXED_RESULTS
+/// comment this line if you don't need to save and restore calibration data (BME280_GetCalibBlob/BME280_InitWithCalib)
+#define USE_CALIB_BLOB
 /// comment this line if you don't need to read single setting with any getX function
 #define USE_GETTERS
 /// comment this line if you don't need to write single setting with any setX function
@@ -47,7 +49,59 @@ extern "C" {
 #define USE_NORMAL_MODE
 /// comment this line if you don't use functionns to read data in forced mode (BME280_ReadxxxForce/BME280_ReadxxxForce_F)
 #define USE_FORCED_MODE
+/// uncomment this line to compensate results of functions with floating point results in floats (MCUs with FPU)
+//#define USE_FLOAT_COMPENSATION
+/// uncomment this line to call bus functions declared in bme280_bus.h directly instead of via #BME280_Driver_t pointers
+//#define USE_STATIC_BUS
+/// uncomment this line to read pressure without temperature with cached t_fine (BME280_SetTempReuse)
+//#define USE_TEMP_REUSE
+/// uncomment this line to keep terms of pressure and humidity compensation which depend on t_fine only
+//#define USE_TFINE_MEMO
+/// uncomment this line to compensate pressure by interpolation in table of knots built around current t_fine
+//#define USE_PRESS_LUT
+/// uncomment this line to compensate integer results in constant time (no data dependent branches and divisions),
+/// pressure costs ~4x more on hosts with hardware divider (x86: median 530 vs 130 cycles) and timing jitter there
+/// gets worse (pressure 326 vs 122 cycles, humidity 160 vs 112), see Examples/Linux/Benchmark/const_time_check.c
+//#define USE_CONST_TIME
+/// uncomment this line to count bus transactions, errors, delays and compensations of every sensor (BME280_GetStats)
+//#define USE_STATS
+/// uncomment this line to call trace function (#BME280_Driver_t) at begin and end of every bus transaction and phase
+//#define USE_TRACE
+/// uncomment this line to record latency histograms of driver operations (BME280_LatencyPercentile)
+//#define USE_LATENCY
+/// uncomment this line to find raw adc values for given results, f.e. to synthesize frames (BME280_InverseFrame)
+//#define USE_INVERSE
+///@}
+
+#if defined(USE_FLOAT_COMPENSATION) && !defined(USE_FLOATS_RESULTS)
+#error "USE_FLOAT_COMPENSATION is used by functions with floating point results, uncomment USE_FLOATS_RESULTS"
+#endif
+
+#if defined(USE_CONST_TIME) && ( defined(USE_TFINE_MEMO) || defined(USE_PRESS_LUT) )
+#error "USE_TFINE_MEMO and USE_PRESS_LUT make time of compensation data dependent, comment them to use USE_CONST_TIME"
+#endif
+
+/* settings above must be visible inside definitions */
+#include "bme280_definitions.h"
+
+#ifdef USE_FIXED_RESULTS
+/**
+ * @defgroup BME280_qscale Fixed-point scales
+ * @brief Scales of values stored in #BME280_DataQ_t
+ *
+ * Use these values to format results when needed, f.e. Data.temp / #BME280_TEMP_Q_DIV gives integer part
+ * of temperature.
+ * @{
+ */
+#define BME280_TEMP_Q_DIV	(100)	///< temperature divisor, result in deg C
+#ifdef USE_64BIT
+#define BME280_PRESS_Q_DIV	(10000UL)	///< pressure divisor, result in hPa
+#else
+#define BME280_PRESS_Q_DIV	(100UL)		///< pressure divisor, result in hPa
+#endif
+#define BME280_HUM_Q_SHIFT	(10U)	///< humidity right shift, result in %
 ///@}
+#endif
 
 /**
  * @defgroup BME280_Pubfunc Public functions
@@ -72,6 +126,66 @@ extern "C" {
  */
 int8_t BME280_Init(BME280_t *Dev, BME280_Driver_t *Driver);
 
+#ifdef USE_CALIB_BLOB
+/**
+ * @brief Function to initialize sensor with calibration data saved before
+ * @note #USE_CALIB_BLOB in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function works like #BME280_Init, but calibration data are taken from *Blob exported before with
+ * #BME280_GetCalibBlob instead of reading them from sensor. Only reset, chip ID and 4 bytes of calibration data
+ * are sent via bus, so time to first sample is shorter. Blob must come from the same sensor - driver checks its CRC
+ * and compares dig_T1 and dig_H2 (trimmed individually for every sensor) with values read from sensor.
+ * @param[in] *Dev pointer to #BME280_t structure which should be initialized
+ * @param[in] *Driver pointer to BME280_Driver_t structure where all platform specific data are stored. This structure
+ * MUST exist while program is running - do not use local structures to init sensor!
+ * @param[in] *Blob pointer to #BME280_CALIB_BLOB_LEN bytes of calibration data
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_ID_ERR sensor's id doesnt match with #BME280_ID
+ * @return #BME280_CALIB_ERR CRC of *Blob doesn't match or *Blob comes from other sensor
+ */
+int8_t BME280_InitWithCalib(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob);
+
+/**
+ * @brief Function exports calibration data of sensor
+ * @note #USE_CALIB_BLOB in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function stores calibration data read during initialization as #BME280_CALIB_BLOB_LEN bytes (image of
+ * calibration registers and CRC-8). No communication with sensor is performed. Save the blob in non-volatile
+ * memory and pass it to #BME280_InitWithCalib later.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[out] *Blob pointer to buffer of #BME280_CALIB_BLOB_LEN bytes where data will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_GetCalibBlob(BME280_t *Dev, uint8_t *Blob);
+#endif
+
+/**
+ * @brief Function to attach to running sensor without reset
+ *
+ * Function can be used instead of #BME280_Init when sensor was configured before (f.e. by previous instance of
+ * application). Reset is not performed, so sensor's settings, IIR filter state and measurements in normal mode
+ * are kept. Function checks chip ID, reads ctrl_hum, status, ctrl_meas and config registers and rebuilds operating
+ * mode inside *Dev structure, so f.e. #BME280_ReadAllLast can be used immediately. If sensor was in the middle of
+ * forced measurement, sleep mode is set.
+ * @param[in] *Dev pointer to #BME280_t structure which should be initialized
+ * @param[in] *Driver pointer to BME280_Driver_t structure where all platform specific data are stored. This structure
+ * MUST exist while program is running - do not use local structures to init sensor!
+ * @param[in] *Blob pointer to #BME280_CALIB_BLOB_LEN bytes of calibration data from #BME280_GetCalibBlob, or NULL
+ * to read calibration data from sensor. Must be NULL if #USE_CALIB_BLOB is not set
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_ID_ERR sensor's id doesnt match with #BME280_ID
+ * @return #BME280_BUSY_ERR sensor is copying calibration data after power-on, try again later
+ * @return #BME280_CALIB_ERR CRC of *Blob doesn't match or *Blob comes from other sensor (checked like in
+ * #BME280_InitWithCalib)
+ */
+int8_t BME280_Attach(BME280_t *Dev, BME280_Driver_t *Driver, const uint8_t *Blob);
+
 /**
  * @brief Function to perform sensor's software reset
  *
@@ -84,6 +198,40 @@ int8_t BME280_Init(BME280_t *Dev, BME280_Driver_t *Driver);
  */
 int8_t BME280_Reset(BME280_t *Dev);
 
+/**
+ * @brief Function returns channels disabled with #BME280_OVERSAMPLING_SKIPP
+ *
+ * Function checks oversampling values of temperature, pressure and humidity in cached copy of control registers.
+ * Registers are read from sensor only if the copy is not valid (f.e. after #BME280_Attach or bus failure). Read
+ * functions and fleet layer use it to mark results as not measured (see @ref BME280_NotMeas).
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[out] *Skipped flags of skipped channels (@ref BME280_Skipped), 0 if all of them are measured
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_GetSkipped(BME280_t *Dev, uint8_t *Skipped);
+
+#ifdef USE_FORCED_MODE
+/**
+ * @brief Function starts single measurement without waiting for the result
+ * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ *
+ * Function sets forced mode and returns max. measurement time, so several sensors can measure at the same time.
+ * Results can be read after this time with f.e. #BME280_CompensateTemp and related functions or by fleet layer.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[out] *Delay max. measurement time in miliseconds
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
+ * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ */
+int8_t BME280_StartForced(BME280_t *Dev, uint8_t *Delay);
+#endif
+
 #ifdef USE_GETTERS
 /**
  * @defgroup BME280_getfunctions Get Functions
@@ -190,6 +338,117 @@ int8_t BME280_Is3WireSPIEnabled(BME280_t *Dev, uint8_t *Result);
  */
 int8_t BME280_ConfigureAll(BME280_t *Dev, BME280_Config_t *Config);
 
+/**
+ * @brief Function to set all sensor settings writing changed registers only
+ *
+ * Function compares *Config with copy of control registers kept inside *Dev structure and writes only these
+ * registers which differ. ctrl_meas is written as the last one and always after ctrl_hum (ctrl_hum takes effect
+ * after ctrl_meas write). Sensor doesn't have to be in #BME280_SLEEPMODE - if config register must be changed in
+ * #BME280_NORMALMODE, sleep mode is set before (writes to config in normal mode may be ignored). If copy of registers
+ * is not valid (f.e. after bus error) they are read once from sensor. It sets current operating mode inside *Dev
+ * structure at the end.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] *Config pointer to #BME280_Config_t structure which contains all paramaters to be set
+ * @param[out] *Saved number of bus transactions saved compared to #BME280_ConfigureAll (read of registers counted),
+ * can be NULL. #BME280_ConfigureAll uses single transaction if #bme280_writeburst or #bme280_transfer function
+ * is set and 3 transactions otherwise
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_ConfigureDiff(BME280_t *Dev, BME280_Config_t *Config, uint8_t *Saved);
+
+#ifdef USE_TEMP_REUSE
+/**
+ * @brief Function sets temperature reuse for pressure reads
+ * @note #USE_TEMP_REUSE in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Pressure compensation needs t_fine calculated from temperature. With reuse enabled functions which read
+ * pressure only (f.e. #BME280_ReadPressLast) read and compensate temperature once per Period + 1 calls, other
+ * calls read 3 bytes of pressure adc instead of 6 and use cached t_fine. Every read of temperature refreshes
+ * t_fine. If temperature changed by more than MaxDelta since previous refresh, t_fine is refreshed again with
+ * next pressure read, until two following refreshes are within MaxDelta.
+ *
+ * Error of pressure equals sensitivity of pressure compensation to t_fine multiplied by temperature change
+ * since last refresh. With example calibration data from datasheet it is about 1.5 Pa per 0.01 DegC, so
+ * MaxDelta of 1 (0.01 DegC) keeps error around 1.5 Pa while temperature drifts slowly. Temperature returned
+ * with pressure comes from cached t_fine. Functions compensated in floats (#USE_FLOAT_COMPENSATION) always
+ * read temperature.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] Period number of pressure reads with cached t_fine between refreshes, 0 disables reuse
+ * @param[in] MaxDelta max. temperature change between refreshes to keep reuse, in 0.01 DegC
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_SetTempReuse(BME280_t *Dev, uint8_t Period, uint16_t MaxDelta);
+#endif
+
+#ifdef USE_STATS
+/**
+ * @brief Function reads performance counters of sensor
+ * @note #USE_STATS in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Counters are cleared by #BME280_Init (and other init functions) and by #BME280_ResetStats, so they include
+ * traffic of initialization as well.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[out] *Stats pointer to structure where copy of counters will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ */
+int8_t BME280_GetStats(BME280_t *Dev, BME280_Stats_t *Stats);
+
+/**
+ * @brief Function clears performance counters of sensor
+ * @note #USE_STATS in @ref BME280_libconf must be uncommented to use this function
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ */
+int8_t BME280_ResetStats(BME280_t *Dev);
+#endif
+
+#ifdef USE_LATENCY
+/**
+ * @brief Function calculates percentile of latency
+ * @note #USE_LATENCY in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function finds bucket with given percentile and returns its upper bound (not more than max. recorded value),
+ * so result is never lower than real percentile. Time is in units of user defined #bme280_clock function.
+ * Function scans #BME280_LAT_BUCKETS counters once, so it is cheap enough to be called often.
+ * @param[in] *Latency pointer to histograms
+ * @param[in] Op operation from @ref BME280_latop
+ * @param[in] Rank percentile in 0.01% units, f.e. 5000 - median, 9900 - p99, 9999 - p99.99, 10000 - max.
+ * @param[out] *Value pointer to variable where percentile will be stored, 0 if histogram is empty
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ */
+int8_t BME280_LatencyPercentile(const BME280_Latency_t *Latency, uint8_t Op, uint16_t Rank, uint32_t *Value);
+
+/**
+ * @brief Function adds histograms to other ones
+ * @note #USE_LATENCY in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Use it to merge histograms of several threads or sensors, both structures must be built with the same
+ * #BME280_LAT_SUB_BITS and #BME280_LAT_MAX_BITS.
+ * @param[in,out] *Dst pointer to histograms where *Src will be added
+ * @param[in] *Src pointer to histograms to add
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ */
+int8_t BME280_LatencyMerge(BME280_Latency_t *Dst, const BME280_Latency_t *Src);
+
+/**
+ * @brief Function clears histograms
+ * @note #USE_LATENCY in @ref BME280_libconf must be uncommented to use this function
+ * @param[out] *Latency pointer to histograms
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ */
+int8_t BME280_LatencyReset(BME280_Latency_t *Latency);
+#endif
+
 #ifdef USE_SETTERS
 /**
  * @defgroup BME280_setfunctions Set Functions
@@ -440,8 +699,12 @@ int8_t BME280_ReadHumLast(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract);
 /**
  * @brief Function forces single measure and returns all data as integers
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads all adc values from sensor, converts them into
  * single variables and compensate with use #BME280_calibration_data. Compensated values are then
@@ -454,14 +717,19 @@ int8_t BME280_ReadHumLast(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadAllForce(BME280_t *Dev, BME280_Data_t *Data);
 
 /**
  * @brief Function forces single measure and returns temperatrue as integers (forced mode)
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads temperature related adc values from sensor, converts them into
  * single variables and compensate with use #BME280_calibration_data. Compensated values are then
@@ -475,14 +743,19 @@ int8_t BME280_ReadAllForce(BME280_t *Dev, BME280_Data_t *Data);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadTempForce(BME280_t *Dev, int8_t *TempInt, uint8_t *TempFract);
 
 /**
  * @brief Function forces single measure and returns pressure as integers (forced mode)
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads temperarure and pressure related adc values from sensor,
  * converts them into single variables and compensate with use #BME280_calibration_data. Compensated values are
@@ -496,14 +769,19 @@ int8_t BME280_ReadTempForce(BME280_t *Dev, int8_t *TempInt, uint8_t *TempFract);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadPressForce(BME280_t *Dev, uint16_t *PressInt, uint16_t *PressFract);
 
 /**
  * @brief Function forces single measure and returns humidity as integers (forced mode)
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads temperarure and humidity related adc values from sensor,
  * converts them into single variables and compensate with use #BME280_calibration_data. Compensated values are
@@ -517,6 +795,7 @@ int8_t BME280_ReadPressForce(BME280_t *Dev, uint16_t *PressInt, uint16_t *PressF
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadHumForce(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract);
 ///@}
@@ -529,6 +808,9 @@ int8_t BME280_ReadHumForce(BME280_t *Dev, uint8_t *HumInt, uint16_t *HumFract);
  * @defgroup BME280_readfl Read Functions (float)
  * @brief read measured data from sensor as floating point values
  * @note #USE_FLOATS_RESULTS in @ref BME280_libconf must be uncommented to use these functions
+ * @note If #USE_FLOAT_COMPENSATION is uncommented, values are compensated with datasheet's floating point
+ * formulas instead of integer ones. Results match integer compensation within 0.02 deg C, 0.001 hPa and 0.01 %RH
+ * (checked by Examples/Linux/Benchmark/float_check.c), #USE_FLOATS_RESULTS is required.
  * @{
  */
 
@@ -620,8 +902,12 @@ int8_t BME280_ReadHumLast_F(BME280_t *Dev, float *Hum);
 /**
  * @brief Function forces single measure and returns all data as floats
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads all adc values from sensor, converts them into
  * single variables and compensate with use #BME280_calibration_data. Compensated values are then
@@ -634,14 +920,19 @@ int8_t BME280_ReadHumLast_F(BME280_t *Dev, float *Hum);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadAllForce_F(BME280_t *Dev, BME280_DataF_t *Data);
 
 /**
  * @brief Function forces single measure and returns temperatrue as floats (forced mode)
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads temperature related adc values from sensor, converts them into
  * single variables and compensate with use #BME280_calibration_data. Compensated values are then
@@ -654,14 +945,19 @@ int8_t BME280_ReadAllForce_F(BME280_t *Dev, BME280_DataF_t *Data);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadTempForce_F(BME280_t *Dev, float *Temp);
 
 /**
  * @brief Function forces single measure and returns pressure as floats (forced mode)
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads temperature and pressure related adc values
  * from sensor, converts them into single variables and compensate with use #BME280_calibration_data.
@@ -674,14 +970,19 @@ int8_t BME280_ReadTempForce_F(BME280_t *Dev, float *Temp);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadPressForce_F(BME280_t *Dev, float *Press);
 
 /**
  * @brief Function forces single measure and returns humidity as floats (forced mode)
  * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
  *
- * Function reads sensor's configuration to check conditions and calculate max. delay time
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
  * required for measure cycle. Then sends command to force single measurement and calls used-defined
  * delay function. When delay function returns ir reads temperature and humidity related adc values
  * from sensor, converts them into single variables and compensate with use #BME280_calibration_data.
@@ -694,12 +995,212 @@ int8_t BME280_ReadPressForce_F(BME280_t *Dev, float *Press);
  * @return #BME280_NO_INIT_ERR sensor was not initialized before
  * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
  * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
  */
 int8_t BME280_ReadHumForce_F(BME280_t *Dev, float *Hum);
 ///@}
 #endif
 ///@}
 #endif
+
+#ifdef USE_FIXED_RESULTS
+/**
+ * @defgroup BME280_readq Read Functions (fixed-point)
+ * @brief read measured data from sensor in native fixed-point format
+ * @note #USE_FIXED_RESULTS in @ref BME280_libconf must be uncommented to use these functions
+ *
+ * These functions return compensated values without any conversion, so no division is performed after compensation.
+ * It is usefull on cores without hardware divider when formatting of results can be deferred.
+ * @{
+ */
+
+#ifdef USE_NORMAL_MODE
+/**
+ * @brief Function reads all measured data at once in fixed-point format
+ * @note Sensor must be in #BME280_NORMALMODE to read last measured values.
+ *
+ * Function reads all adc values from sensor, converts them into single variables and compensate
+ * with use #BME280_calibration_data. Compensated values are stored in #BME280_DataQ_t structure without
+ * any conversion.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[out] *Data pointer to structure where result will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ * @return #BME280_CONDITION_ERR sensor is not in #BME280_NORMALMODE
+ */
+int8_t BME280_ReadAllLast_Q(BME280_t *Dev, BME280_DataQ_t *Data);
+#endif
+
+#ifdef USE_FORCED_MODE
+/**
+ * @brief Function forces single measure and returns all data in fixed-point format
+ * @note Sensor must be in #BME280_SLEEPMODE to force a single measurement.
+ * @note Busy status is checked before trigger only when cached configuration must be read (first use or after
+ * bus failure). While cache is valid this check is skipped and busy sensor is detected by status read after delay.
+ * Oversampling registers are read together with status and compared with cache, so sensor reset meanwhile (f.e.
+ * by brown-out) is detected without additional transaction.
+ *
+ * Function uses sensor's configuration (read once and cached) to check conditions and calculate max. delay time
+ * required for measure cycle. Then sends command to force single measurement and calls used-defined
+ * delay function. When delay function returns ir reads all adc values from sensor, converts them into
+ * single variables and compensate with use #BME280_calibration_data. Compensated values are stored in
+ * #BME280_DataQ_t structure without any conversion.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[out] *Data pointer to structure where result will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ * @return #BME280_CONDITION_ERR sensor is not in #BME280_SLEEPMODE
+ * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+ * @return #BME280_STATE_ERR sensor settings differ from cache, configure it again
+ */
+int8_t BME280_ReadAllForce_Q(BME280_t *Dev, BME280_DataQ_t *Data);
+
+/**
+ * @brief Function initializes sensor and takes first sample as fast as possible
+ *
+ * Function replaces #BME280_Init, #BME280_ConfigureAll and #BME280_ReadAllForce_Q sequence. After reset and chip
+ * ID check it writes configuration and starts forced measurement before calibration data are read, so time of
+ * calibration readout is hidden inside measurement time. Then sensor's status is polled every 1ms until
+ * measurement is completed. Usefull when device wakes up to take single sample only.
+ * @note Config->mode is ignored, sensor is left in #BME280_SLEEPMODE
+ * @param[in] *Dev pointer to #BME280_t structure which should be initialized
+ * @param[in] *Driver pointer to BME280_Driver_t structure where all platform specific data are stored. This structure
+ * MUST exist while program is running - do not use local structures to init sensor!
+ * @param[in] *Config pointer to #BME280_Config_t structure which contains configuration
+ * @param[out] *Data pointer to structure where result will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined read/write function returned non-zero value
+ * @return #BME280_ID_ERR sensor's id doesnt match with #BME280_ID
+ * @return #BME280_BUSY_ERR measurement was not completed in expected time
+ */
+int8_t BME280_InitForce_Q(BME280_t *Dev, BME280_Driver_t *Driver, BME280_Config_t *Config, BME280_DataQ_t *Data);
+#endif
+
+/**
+ * @defgroup BME280_compq Compensation Functions
+ * @brief compensate raw adc values read by user
+ *
+ * These functions give access to compensation formulas only, no communication with sensor is performed. They are
+ * usefull when adc registers are read outside the driver (f.e. by C++ wrapper or several sensors at once).
+ * @{
+ */
+
+/**
+ * @brief Function compensates raw temperature
+ *
+ * Function compensates raw adc value of temperature with use #BME280_calibration_data. It updates t_fine
+ * inside *Dev structure, so it must be called before #BME280_CompensatePress and #BME280_CompensateHum.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] AdcT raw 20-bit adc value of temperature
+ * @param[out] *Temp pointer to variable where temperature in 0.01 deg C will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_CompensateTemp(BME280_t *Dev, BME280_S32_t AdcT, BME280_S32_t *Temp);
+
+/**
+ * @brief Function compensates raw pressure
+ *
+ * Function compensates raw adc value of pressure with use #BME280_calibration_data and t_fine calculated
+ * by last call of #BME280_CompensateTemp. If #USE_PRESS_LUT is set, pressure is interpolated as described
+ * in @ref BME280_presslut.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] AdcP raw 20-bit adc value of pressure
+ * @param[out] *Press pointer to variable where pressure will be stored (scale as in #BME280_DataQ_t)
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_CompensatePress(BME280_t *Dev, BME280_S32_t AdcP, BME280_U32_t *Press);
+
+/**
+ * @brief Function compensates raw humidity
+ *
+ * Function compensates raw adc value of humidity with use #BME280_calibration_data and t_fine calculated
+ * by last call of #BME280_CompensateTemp.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] AdcH raw 16-bit adc value of humidity
+ * @param[out] *Hum pointer to variable where humidity in Q22.10 format will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_CompensateHum(BME280_t *Dev, BME280_S32_t AdcH, BME280_U32_t *Hum);
+
+#ifdef USE_INVERSE
+/**
+ * @brief Function finds raw temperature for given temperature
+ * @note #USE_INVERSE in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function searches adc value which gives Temp when compensated with #BME280_CompensateTemp (or the nearest
+ * temperature if Temp is out of range of sensor). Search starts with secant steps, so few compensations are
+ * needed. It updates t_fine inside *Dev structure like #BME280_CompensateTemp called with found value, so it
+ * must be called before #BME280_InversePress and #BME280_InverseHum.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] Temp temperature in 0.01 deg C
+ * @param[out] *AdcT pointer to variable where raw 20-bit adc value will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_InverseTemp(BME280_t *Dev, BME280_S32_t Temp, BME280_S32_t *AdcT);
+
+/**
+ * @brief Function finds raw pressure for given pressure
+ * @note #USE_INVERSE in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function searches adc value which gives Press when compensated with #BME280_CompensatePress at t_fine of
+ * last #BME280_InverseTemp or #BME280_CompensateTemp (or the nearest pressure if Press is out of range).
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] Press pressure (scale as in #BME280_DataQ_t)
+ * @param[out] *AdcP pointer to variable where raw 20-bit adc value will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_InversePress(BME280_t *Dev, BME280_U32_t Press, BME280_S32_t *AdcP);
+
+/**
+ * @brief Function finds raw humidity for given humidity
+ * @note #USE_INVERSE in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function searches adc value which gives Hum when compensated with #BME280_CompensateHum at t_fine of
+ * last #BME280_InverseTemp or #BME280_CompensateTemp (or the nearest humidity if Hum is out of range).
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] Hum humidity in Q22.10 format
+ * @param[out] *AdcH pointer to variable where raw 16-bit adc value will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_InverseHum(BME280_t *Dev, BME280_U32_t Hum, BME280_S32_t *AdcH);
+
+/**
+ * @brief Function synthesizes adc registers for given results
+ * @note #USE_INVERSE in @ref BME280_libconf must be uncommented to use this function
+ *
+ * Function finds raw values of all channels (see #BME280_InverseTemp) and stores them as content of adc registers
+ * (#BME280_PRESS_ADC_ADDR and following), like read from sensor. Values marked as not measured (see
+ * @ref BME280_NotMeas) are stored as skipped measurements. Use it to feed the driver with realistic data without
+ * sensor, f.e. from recorded weather or HVAC traces.
+ * @param[in] *Dev pointer to sensor's #BME280_t structure
+ * @param[in] *Data pointer to results in native fixed-point format
+ * @param[out] *Frame pointer to buffer of #BME280_PRESS_ADC_LEN + #BME280_TEMP_ADC_LEN + #BME280_HUM_ADC_LEN bytes
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_NO_INIT_ERR sensor was not initialized before
+ */
+int8_t BME280_InverseFrame(BME280_t *Dev, const BME280_DataQ_t *Data, uint8_t *Frame);
+#endif
+///@}
+///@}
+#endif
 ///@}
 
 
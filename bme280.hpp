@@ -0,0 +1,282 @@
+/**
+ *******************************************
+ * @file    bme280.hpp
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Header-only C++17 wrapper for BME280 Driver
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_Driver
+ * @{
+ */
+
+//***************************************
+
+#ifndef BME280_HPP
+#define BME280_HPP
+
+//***************************************
+
+#include <stdint.h>
+#include "bme280.h"
+
+#ifndef USE_FIXED_RESULTS
+#error "bme280.hpp requires USE_FIXED_RESULTS in bme280.h"
+#endif
+
+/**
+ * @defgroup BME280_cpp C++ Wrapper
+ * @brief Sensor with configuration resolved at compile time
+ *
+ * Whole configuration is a template parameter, so ctrl_hum, ctrl_meas and config register values, forced mode
+ * measurement time and range of adc registers to read are computed by compiler. Channels which are skipped
+ * in configuration are not read nor compensated, and bus functions are called directly (not via pointers) in
+ * read path, so they can be inlined. Each #bme280::Sensor specialization is independent, so several sensors
+ * with different configurations can be used in one binary.
+ *
+ * Bus policy must be a type with three static functions:
+ * @code
+ * struct MyBus {
+ * 	static int8_t read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen);
+ * 	static int8_t write(uint8_t reg_addr, uint8_t value);
+ * 	static void delay(uint8_t delay_time);
+ * };
+ *
+ * bme280::Sensor<MyBus, bme280::Config<bme280::Osrs::X2, bme280::Osrs::X2, bme280::Osrs::X4,
+ * 		bme280::Filter::F2>> bme;
+ * @endcode
+ * Rules for read/write functions are the same as for #bme280_readregisters and #bme280_writeregister.
+ * @{
+ */
+namespace bme280 {
+
+	/// oversampling, see @ref BME280_Ovs
+enum class Osrs : uint8_t {
+
+	Skip = BME280_OVERSAMPLING_SKIPP,
+	X1 = BME280_OVERSAMPLING_X1,
+	X2 = BME280_OVERSAMPLING_X2,
+	X4 = BME280_OVERSAMPLING_X4,
+	X8 = BME280_OVERSAMPLING_X8,
+	X16 = BME280_OVERSAMPLING_X16
+};
+
+	/// IIR filter coefficient, see @ref BME280_filter
+enum class Filter : uint8_t {
+
+	Off = BME280_FILTER_OFF,
+	F2 = BME280_FILTER_2,
+	F4 = BME280_FILTER_4,
+	F8 = BME280_FILTER_8,
+	F16 = BME280_FILTER_16
+};
+
+	/// standby time in normal mode, see @ref BME280_tstby
+enum class Standby : uint8_t {
+
+	Ms0_5 = BME280_STBY_0_5MS,
+	Ms62_5 = BME280_STBY_62_5MS,
+	Ms125 = BME280_STBY_125MS,
+	Ms250 = BME280_STBY_250MS,
+	Ms500 = BME280_STBY_500MS,
+	Ms1000 = BME280_STBY_1000MS,
+	Ms10 = BME280_STBY_10MS,
+	Ms20 = BME280_STBY_20MS
+};
+
+	/// operating mode used to take measurements, see @ref BME280_mode
+enum class Mode : uint8_t {
+
+	Forced = BME280_FORCEDMODE,	///< single measurement is forced by every read
+	Normal = BME280_NORMALMODE	///< sensor measures continuously, read returns last measurement
+};
+
+/**
+ * @brief Compile-time sensor configuration
+ *
+ * Template parameters are temperature, pressure and humidity oversampling, filter, standby time and operating mode.
+ * Temperature can't be skipped - it is required to compensate pressure and humidity.
+ */
+template <Osrs OsrsT, Osrs OsrsP, Osrs OsrsH, Filter Flt = Filter::Off, Standby Stby = Standby::Ms0_5,
+	Mode Md = Mode::Forced>
+struct Config {
+
+	static_assert(OsrsT != Osrs::Skip, "temperature is required to compensate pressure and humidity");
+
+	static constexpr Mode mode = Md;	///< operating mode
+
+	static constexpr bool has_press = (OsrsP != Osrs::Skip);	///< pressure is measured
+	static constexpr bool has_hum = (OsrsH != Osrs::Skip);		///< humidity is measured
+
+	/// value of ctrl_hum register
+	static constexpr uint8_t ctrl_hum = static_cast<uint8_t>(OsrsH) & 0x07;
+
+	/// value of ctrl_meas register without mode bits (sleep mode)
+	static constexpr uint8_t ctrl_meas = static_cast<uint8_t>(((static_cast<uint8_t>(OsrsT) << 5) & 0xE0) |
+			((static_cast<uint8_t>(OsrsP) << 2) & 0x1C));
+
+	/// value of ctrl_meas register which starts measurements in selected mode
+	static constexpr uint8_t ctrl_meas_run = static_cast<uint8_t>(ctrl_meas | static_cast<uint8_t>(Md));
+
+	/// value of config register
+	static constexpr uint8_t config = static_cast<uint8_t>(((static_cast<uint8_t>(Stby) << 5) & 0xE0) |
+			((static_cast<uint8_t>(Flt) << 2) & 0x1C));
+
+	/// max. measurement time in forced mode [ms]
+	static constexpr uint8_t meas_time = BME280_MEAS_TIME_MS(static_cast<uint8_t>(OsrsT),
+			static_cast<uint8_t>(OsrsP), static_cast<uint8_t>(OsrsH));
+
+	/// first adc register to read in burst
+	static constexpr uint8_t read_addr = has_press ? BME280_PRESS_ADC_ADDR : BME280_TEMP_ADC_ADDR;
+
+	/// number of adc registers to read in burst
+	static constexpr uint8_t read_len = static_cast<uint8_t>((has_hum ? (BME280_HUM_ADC_ADDR + BME280_HUM_ADC_LEN) :
+			(BME280_TEMP_ADC_ADDR + BME280_TEMP_ADC_LEN)) - read_addr);
+
+	/// equivalent runtime configuration, used with #BME280_ConfigureAll
+	static constexpr BME280_Config_t runtime(){
+
+		return BME280_Config_t{ static_cast<uint8_t>(OsrsH), static_cast<uint8_t>(OsrsP),
+			static_cast<uint8_t>(OsrsT), BME280_SLEEPMODE, static_cast<uint8_t>(Stby), static_cast<uint8_t>(Flt), 0 };
+	}
+};
+
+/**
+ * @brief Single sensor with compile-time configuration
+ *
+ * Calibration data are read by C driver during #init, measurements are read directly with Bus functions.
+ * Object can't be copied nor moved, because C driver keeps pointer to its members.
+ * @tparam Bus bus policy with static read, write and delay functions
+ * @tparam Cfg #bme280::Config specialization
+ */
+template <class Bus, class Cfg>
+class Sensor {
+
+public:
+
+	Sensor() = default;
+
+	/* C driver keeps pointer to drv_ inside dev_, so object can't be copied nor moved */
+	Sensor(const Sensor &) = delete;
+	Sensor(Sensor &&) = delete;
+	Sensor &operator=(const Sensor &) = delete;
+	Sensor &operator=(Sensor &&) = delete;
+
+	/**
+	 * @brief Function initializes sensor and writes configuration
+	 *
+	 * Function calls #BME280_Init and #BME280_ConfigureAll. If #bme280::Mode::Normal is configured, normal
+	 * mode is started at the end.
+	 * @return values returned by #BME280_Init and #BME280_ConfigureAll
+	 */
+	int8_t init(){
+
+		int8_t res;
+		BME280_Config_t config = Cfg::runtime();
+
+		drv_.read = &Sensor::read_cb;
+		drv_.write = &Sensor::write_cb;
+		drv_.delay = &Bus::delay;
+		drv_.env_spec_data = nullptr;
+		drv_.i2c_address = 0;
+
+		res = BME280_Init(&dev_, &drv_);
+		if(BME280_OK != res) return res;
+
+		if constexpr (Mode::Normal == Cfg::mode){
+
+			config.mode = BME280_NORMALMODE;
+		}
+
+		return BME280_ConfigureAll(&dev_, &config);
+	}
+
+	/**
+	 * @brief Function reads measured data
+	 *
+	 * In #bme280::Mode::Forced function forces single measurement, waits #bme280::Config::meas_time and checks
+	 * if sensor is not busy. In #bme280::Mode::Normal it reads last measured values. Only channels enabled in
+	 * configuration are read and compensated, remaining members of *Data are not changed.
+	 * @param[out] Data structure where result will be stored
+	 * @return #BME280_OK success
+	 * @return #BME280_INTERFACE_ERR bus function returned non-zero value
+	 * @return #BME280_NO_INIT_ERR sensor was not initialized before
+	 * @return #BME280_BUSY_ERR sensor is busy so cannot proceed
+	 */
+	int8_t read(BME280_DataQ_t &Data){
+
+		uint8_t raw[Cfg::read_len];
+		const uint8_t *t_raw = &raw[BME280_TEMP_ADC_ADDR - Cfg::read_addr];
+
+		if(0 == dev_.initialized) return BME280_NO_INIT_ERR;
+
+		if constexpr (Mode::Forced == Cfg::mode){
+
+			uint8_t status;
+
+			/* force single measure and wait until it ends */
+			if(0 != Bus::write(BME280_CTRL_MEAS_ADDR, Cfg::ctrl_meas_run)) return BME280_INTERFACE_ERR;
+			Bus::delay(Cfg::meas_time);
+
+			/* check if measure is completed, mask bits "measuring" and "im_update" */
+			if(0 != Bus::read(BME280_STATUS_ADDR, &status, 1)) return BME280_INTERFACE_ERR;
+			if(0 != (status & 0x09)) return BME280_BUSY_ERR;
+		}
+
+		/* read required adc registers only */
+		if(0 != Bus::read(Cfg::read_addr, raw, Cfg::read_len)) return BME280_INTERFACE_ERR;
+
+		BME280_CompensateTemp(&dev_, parse20(t_raw), &Data.temp);
+
+		if constexpr (Cfg::has_press){
+
+			BME280_CompensatePress(&dev_, parse20(&raw[0]), &Data.press);
+		}
+
+		if constexpr (Cfg::has_hum){
+
+			const uint8_t *h_raw = &raw[BME280_HUM_ADC_ADDR - Cfg::read_addr];
+			BME280_CompensateHum(&dev_, (static_cast<BME280_S32_t>(h_raw[0]) << 8) | h_raw[1], &Data.hum);
+		}
+
+		return BME280_OK;
+	}
+
+	/// access to underlying C driver structure, f.e. to use functions from bme280.h
+	BME280_t &device(){ return dev_; }
+
+private:
+
+	/* parse 20-bit adc value of temperature or pressure */
+	static BME280_S32_t parse20(const uint8_t *raw){
+
+		return (static_cast<BME280_S32_t>(raw[0]) << 12) | (static_cast<BME280_S32_t>(raw[1]) << 4) |
+				(static_cast<BME280_S32_t>(raw[2]) >> 4);
+	}
+
+	/* callbacks used by C driver during initialization */
+	static int8_t read_cb(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+		(void)driver;
+		return Bus::read(reg_addr, rxbuff, rxlen);
+	}
+
+	static int8_t write_cb(uint8_t reg_addr, uint8_t value, void *driver){
+
+		(void)driver;
+		return Bus::write(reg_addr, value);
+	}
+
+	BME280_t dev_{};
+	BME280_Driver_t drv_{};
+};
+
+} /* namespace bme280 */
+///@}
+
+#endif /* BME280_HPP */
+
+///@}
@@ -0,0 +1,81 @@
+/**
+ *******************************************
+ * @file    bme280_bus.h
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Static bus binding for BME280 Driver
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_Driver
+ * @{
+ */
+
+//***************************************
+
+#ifndef BME280_BUS_H
+#define BME280_BUS_H
+
+//***************************************
+
+#include "bme280.h"
+
+/**
+ * @defgroup BME280_staticbus Static Bus Binding
+ * @brief Platform specific functions bound at compile time
+ * @note #USE_STATIC_BUS in @ref BME280_libconf must be uncommented to use these functions
+ *
+ * This file is included by bme280.c only when #USE_STATIC_BUS is set. Driver calls functions below directly
+ * instead of pointers stored inside #BME280_Driver_t (these pointers can be left NULL). Rules are the same as
+ * for @ref BME280_prots. Binding is common for all sensors of the build, use "driver" parameter to tell them apart.
+ *
+ * Implement these functions in any source file - with link time optimization they can be inlined into driver.
+ * To get inlining without LTO, put "static inline" definitions of these functions into own header and pass its
+ * name in BME280_BUS_HEADER when compiling bme280.c (this file is not included then, so it doesn't need to be
+ * modified), f.e. -DBME280_BUS_HEADER='"my_bus.h"' with my_bus.h:
+ * @code
+ * #include "bme280.h"
+ *
+ * static inline int8_t bme280_static_write(uint8_t reg_addr, uint8_t value, void *driver){
+ *
+ * 	return my_i2c_write(((BME280_Driver_t *)driver)->i2c_address, reg_addr, value);
+ * }
+ * ...
+ * @endcode
+ * If bus functions can't fail, return constant 0 - driver's error branches will be removed by compiler.
+ * @{
+ */
+
+/**
+ * Function to read the data from sensor's registers in burst mode, see #bme280_readregisters
+ * @param[in] reg_addr address of register to be read (f.e. #BME280_ID_ADDR)
+ * @param[in] *rxbuff pointer to the buffer where data will be stored
+ * @param[in] rxlen lenght of data to be read (in bytes)
+ * @param[in] *driver pointer to #BME280_Driver_t structure
+ * @return 0 success
+ * @return -1 failure
+ */
+int8_t bme280_static_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+
+/**
+ * Function to write data to a single register, see #bme280_writeregister
+ * @param[in] reg_addr address of register to be written (f.e. #BME280_RESET_ADDR)
+ * @param[in] value value to write (f.e. #BME280_RESET_VALUE)
+ * @param[in] *driver pointer to #BME280_Driver_t structure
+ * @return 0 success
+ * @return -1 failure
+ */
+int8_t bme280_static_write(uint8_t reg_addr, uint8_t value, void *driver);
+
+/**
+ * Delay function, see #bme280_delayms
+ * @param[in] delay_time time to delay in miliseconds
+ */
+void bme280_static_delay(uint8_t delay_time);
+///@}
+
+#endif /* BME280_BUS_H */
+
+///@}
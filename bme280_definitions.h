@@ -35,6 +35,37 @@
 #define BME280_NO_INIT_ERR		(-4)	///< device wasn't initialized properly and operation cannot be performed
 #define BME280_CONDITION_ERR	(-5)	///< device is set to wrong operation mode, cannot perform operation
 #define BME280_BUSY_ERR			(-6)	///< device is busy
+#define BME280_CALIB_ERR		(-7)	///< calibration blob is corrupted or belongs to other sensor
+#define BME280_STATE_ERR		(-8)	///< device settings differ from cached ones (f.e. after reset), configure it again
+///@}
+
+/**
+ * @defgroup BME280_NotMeas BME280 Not Measured Markers
+ * @brief Values returned instead of results of measurements disabled with #BME280_OVERSAMPLING_SKIPP
+ *
+ * Pressure and humidity are marked as not measured when temperature is skipped as well, because their
+ * compensation requires temperature. Functions with floating point results return NAN instead.
+ * @{
+ */
+#define BME280_TEMP_NOT_MEASURED		(INT32_MIN)		///< temperature in 0.01 deg C (f.e. "temp" of #BME280_DataQ_t)
+#define BME280_PRESS_NOT_MEASURED		(UINT32_MAX)	///< pressure in fixed-point format (f.e. "press" of #BME280_DataQ_t)
+#define BME280_HUM_NOT_MEASURED			(UINT32_MAX)	///< humidity in Q22.10 format (f.e. "hum" of #BME280_DataQ_t)
+#define BME280_TEMP_INT_NOT_MEASURED	(INT8_MIN)		///< "temp_int" of #BME280_Data_t, "temp_fract" is 0
+#define BME280_PRESS_INT_NOT_MEASURED	(UINT16_MAX)	///< "pressure_int" of #BME280_Data_t, "pressure_fract" is 0
+#define BME280_HUM_INT_NOT_MEASURED		(UINT8_MAX)		///< "humidity_int" of #BME280_Data_t, "humidity_fract" is 0
+///@}
+
+/**
+ * @defgroup BME280_Skipped BME280 Skipped Channels
+ * @brief Flags of channels disabled with #BME280_OVERSAMPLING_SKIPP, see #BME280_GetSkipped
+ *
+ * Skipped channels are found from oversampling values of control registers, never from adc values, because
+ * every adc value can be a valid result of measurement.
+ * @{
+ */
+#define BME280_SKIPPED_TEMP		(0x01)	///< temperature is not measured
+#define BME280_SKIPPED_PRESS	(0x02)	///< pressure is not measured
+#define BME280_SKIPPED_HUM		(0x04)	///< humidity is not measured
 ///@}
 
 /**
@@ -66,6 +97,7 @@
 #define BME280_CALIB_DATA1_LEN	(25U)	///< lenght of first block with calibration data
 #define BME280_CALIB_DATA2_ADDR	(0xE1)	///< address of second block with calibration data
 #define BME280_CALIB_DATA2_LEN	(7U)	///< lenght of second block with calibration data
+#define BME280_CALIB_BLOB_LEN	(33U)	///< lenght of calibration blob (both blocks + CRC-8)
 
 	/* control and config related */
 #define BME280_CTRL_HUM_ADDR	(0xF2)	///< address of ctrl_hum register
@@ -79,6 +111,8 @@
 #define BME280_TEMP_ADC_LEN		(3U)	///< lenght of temperature adc data
 #define BME280_HUM_ADC_ADDR		(0xFD)	///< address of humidity adc data
 #define BME280_HUM_ADC_LEN		(2U)	///< lenght of humidity adc data
+#define BME280_PRESS_TEMP_ADC_SKIPPED	(0x80000)	///< pressure or temperature adc value stored by sensor when measurement is skipped
+#define BME280_HUM_ADC_SKIPPED	(0x8000)	///< humidity adc value stored by sensor when measurement is skipped
 
 	/* status register */
 #define BME280_STATUS_ADDR		(0xF3)	///< address of status register
@@ -117,6 +151,50 @@
 #define BME280_NORMALMODE	(0x03)	///< normal mode
 ///@}
 
+/**
+ *
+ * @defgroup BME280_optype Operation Type
+ * @brief Types of operations used with #bme280_transfer function.
+ * @{
+ */
+#define BME280_OP_WRITE		(0x00)	///< write single register
+#define BME280_OP_READ		(0x01)	///< read registers in burst mode
+#define BME280_OP_DELAY		(0x02)	///< delay
+///@}
+
+/**
+ *
+ * @defgroup BME280_traceev Trace Events
+ * @brief Events passed to #bme280_trace function, "arg" parameter is described for every event
+ *
+ * Bus events are reported by every call of user defined bus function, phases group bus events of single
+ * driver step. Events of one sensor are properly nested, phases contain bus events.
+ * When transfer function is set, forced read is passed to it as single list of operations, so its
+ * #BME280_TRACE_TRIGGER phase contains one #BME280_TRACE_TRANSFER event only: wait, status read and adc read
+ * are done inside user function and are not reported as #BME280_TRACE_WAIT or #BME280_TRACE_BURST_READ.
+ * @{
+ */
+#define BME280_TRACE_READ			(0x01)	///< (bus) read registers, arg - register address
+#define BME280_TRACE_WRITE			(0x02)	///< (bus) write single register, arg - register address
+#define BME280_TRACE_WRITE_BURST	(0x03)	///< (bus) write several registers, arg - number of registers
+#define BME280_TRACE_TRANSFER		(0x04)	///< (bus) list of operations, arg - number of operations
+#define BME280_TRACE_WAIT			(0x05)	///< (bus) delay, arg - time in miliseconds
+#define BME280_TRACE_BUSY_CHECK		(0x10)	///< (phase) check of mode and busy bits before forced measurement
+#define BME280_TRACE_TRIGGER		(0x11)	///< (phase) forced measurement (trigger, wait, status read, adc read, or single transfer), arg - wait time
+#define BME280_TRACE_BURST_READ		(0x12)	///< (phase) read of adc registers, arg - lenght
+#define BME280_TRACE_COMPENSATE		(0x13)	///< (phase) compensation of adc data
+///@}
+
+/**
+ *
+ * @defgroup BME280_traceedge Trace Edges
+ * @brief Second parameter of #bme280_trace function
+ * @{
+ */
+#define BME280_TRACE_BEGIN	(0x00)	///< event begins
+#define BME280_TRACE_END	(0x01)	///< event ends
+///@}
+
 /**
  *
  * @defgroup BME280_tstby Standby Time
@@ -150,6 +228,22 @@
 
 ///@}
 
+/**
+ * @defgroup BME280_meastime Measurement Time
+ * @brief Calculation of max. measurement time in forced mode
+ *
+ * Values are calculated according to datasheet (appendix B). Macros can be used in constant expressions.
+ * @{
+ */
+	/// converts osrs_x register value to oversampling value, f.e. #BME280_OVERSAMPLING_X8 gives 8
+#define BME280_OSRS_TO_OVS(osrs)	((osrs) <= BME280_OVERSAMPLING_X2 ? (osrs) : \
+		((osrs) < BME280_OVERSAMPLING_X16 ? (1U << ((osrs) - 1U)) : 16U))
+
+	/// max. measurement time in ms (rounded up) for osrs_x register values in range of @ref BME280_Ovs
+#define BME280_MEAS_TIME_MS(osrs_t, osrs_p, osrs_h)	((uint8_t)(((125U + (230U * BME280_OSRS_TO_OVS(osrs_t)) + \
+		((230U * BME280_OSRS_TO_OVS(osrs_p)) + 58U) + ((230U * BME280_OSRS_TO_OVS(osrs_h)) + 58U)) / 100U) + 1U))
+///@}
+
 /**
  * @defgroup BME280_prots Function pointers
  * @brief Platform speicific functions
@@ -183,6 +277,78 @@ typedef int8_t (*bme280_readregisters)(uint8_t reg_addr, uint8_t *rxbuff, uint8_
  */
 typedef int8_t (*bme280_writeregister)(uint8_t reg_addr, uint8_t value, void *driver);
 
+/**
+ * Function to write several registers in single transaction (optional).
+ *
+ * "pairs" contains "count" (register address, value) pairs: reg0, value0, reg1, value1... Sensor accepts such
+ * sequence in one I2C write transaction (after slave address) or one SPI frame (with single CS assertion).
+ * Pairs must be sent in the same order as they are stored.
+ * @attention when use I2C bus, function must control LSB of I2C address value! Check datasheet and examples
+ * @attention when use SPI bus, function must reset MSB of every register address! Check datasheet and examples
+ * @param[in] *pairs pointer to (register address, value) pairs
+ * @param[in] count number of pairs
+ * @param[in] *driver pointer to #BME280_Driver_t structure
+ * @return 0 success
+ * @return -1 failure
+ */
+typedef int8_t (*bme280_writeburst)(const uint8_t *pairs, uint8_t count, void *driver);
+
+/**
+ * @struct BME280_Op_t
+ * @brief Single operation passed to #bme280_transfer function
+ * @{
+ */
+typedef struct {
+
+	uint8_t type;		///< type of operation, #BME280_OP_WRITE, #BME280_OP_READ or #BME280_OP_DELAY
+	uint8_t reg_addr;	///< (write, read) address of register
+	uint8_t value;		///< (write) value to write, (delay) time to delay in miliseconds
+	uint8_t len;		///< (read) lenght of data to be read (in bytes)
+	uint8_t *rxbuff;	///< (read) pointer to the buffer where data will be stored
+
+} BME280_Op_t;
+///@}
+
+/**
+ * Function to execute list of operations (optional).
+ *
+ * Operations must be executed in the same order as they are stored, and function should stop at first failure.
+ * Each operation works like #bme280_writeregister, #bme280_readregisters or #bme280_delayms. Backend can merge
+ * them into single transfer, f.e. Linux i2c-dev can send all messages between delays with one I2C_RDWR ioctl,
+ * DMA controller can chain descriptors.
+ * @attention same rules for I2C address and SPI register address apply as for read and write functions
+ * @param[in] *ops pointer to array of operations
+ * @param[in] count number of operations
+ * @param[in] *driver pointer to #BME280_Driver_t structure
+ * @return 0 success
+ * @return -1 failure
+ */
+typedef int8_t (*bme280_transfer)(const BME280_Op_t *ops, uint8_t count, void *driver);
+
+/**
+ * Trace function (optional).
+ *
+ * Function is called at begin and end of every event from @ref BME280_traceev and should store event with
+ * timestamp of monotonic clock (f.e. CLOCK_MONOTONIC on Linux, cycle counter or timer on MCU). It is called from
+ * the same context as bus functions, so it must be short and must not call driver functions.
+ * @note #USE_TRACE in @ref BME280_libconf must be uncommented to use this function
+ * @param[in] event event from @ref BME280_traceev
+ * @param[in] edge #BME280_TRACE_BEGIN or #BME280_TRACE_END
+ * @param[in] arg argument of event, the same for begin and end
+ * @param[in] *driver pointer to #BME280_Driver_t structure
+ */
+typedef void (*bme280_trace)(uint8_t event, uint8_t edge, uint8_t arg, void *driver);
+
+/**
+ * Clock function (optional).
+ *
+ * Function returns current value of monotonic clock (f.e. microseconds or CPU cycles). Counter may wrap around,
+ * driver uses difference of two readings only.
+ * @note #USE_LATENCY in @ref BME280_libconf must be uncommented to use this function
+ * @return current time
+ */
+typedef uint32_t (*bme280_clock)(void);
+
 /**
  * Delay function.
  * @param[in] delay_time time to delay in miliseconds
@@ -233,6 +399,270 @@ struct BME280_calibration_data {
 };
 ///@}
 
+#ifdef USE_FLOAT_COMPENSATION
+/**
+ * @struct BME280_float_calibration
+ * @brief Keeps calibration data prepared for floating point compensation
+ * @note User should not manipulate this structure. It is only for internal library use.
+ *
+ * All constant divisors of datasheet's floating point formulas are folded into these coefficients while
+ * calibration data are read, so compensation needs multiplications and a single division only.
+ * @{
+ */
+struct BME280_float_calibration {
+
+	float t1_1024;	///< dig_T1 / 1024
+	float t1_8192;	///< dig_T1 / 8192
+	float t2;		///< dig_T2
+	float t3;		///< dig_T3
+
+	float p1;		///< dig_P1
+	float p1_32768;	///< dig_P1 / 32768
+	float p2;		///< dig_P2 / 524288
+	float p3;		///< dig_P3 / 524288^2
+	float p4;		///< dig_P4 * 65536
+	float p5;		///< dig_P5 * 2
+	float p6;		///< dig_P6 / 32768
+	float p7;		///< dig_P7 / 16
+	float p8;		///< dig_P8 / 524288
+	float p9;		///< dig_P9 / 2^35
+
+	float h1;		///< dig_H1 / 524288
+	float h2;		///< dig_H2 / 65536
+	float h3;		///< dig_H3 / 67108864
+	float h4;		///< dig_H4 * 64
+	float h5;		///< dig_H5 / 16384
+	float h6;		///< dig_H6 / 67108864
+};
+///@}
+#endif
+
+/**
+ * @struct BME280_register_cache
+ * @brief Keeps copy of control registers as they were written to sensor
+ * @note User should not manipulate this structure. It is only for internal library use.
+ *
+ * Cache is updated by every write done by the driver. ctrl_meas is stored without forced mode bits, because
+ * sensor returns to sleep mode by itself after forced measurement.
+ * @{
+ */
+struct BME280_register_cache {
+
+	uint8_t ctrl_hum;	///< copy of ctrl_hum register
+	uint8_t ctrl_meas;	///< copy of ctrl_meas register
+	uint8_t config;		///< copy of config register
+	uint8_t valid;		///< 1 if copy matches sensor's registers, 0 if it must be read again
+};
+///@}
+
+#ifdef USE_TEMP_REUSE
+/**
+ * @struct BME280_temp_reuse
+ * @brief Keeps state of temperature reuse for pressure only reads
+ * @note User should not manipulate this structure. It is only for internal library use.
+ * @{
+ */
+struct BME280_temp_reuse {
+
+	BME280_S32_t temp;	///< temperature measured at last refresh of t_fine (0.01 DegC)
+	uint16_t max_delta;	///< max. change of temperature between refreshes to keep reuse (0.01 DegC)
+	uint8_t period;		///< number of pressure reads with cached t_fine between refreshes, 0 - reuse disabled
+	uint8_t left;		///< number of pressure reads left until next refresh
+	uint8_t valid;		///< 1 if "temp" was measured at least once
+};
+///@}
+#endif
+
+#ifdef USE_TFINE_MEMO
+/**
+ * @struct BME280_tfine_memo
+ * @brief Keeps terms of pressure and humidity compensation which depend on t_fine only
+ * @note User should not manipulate this structure. It is only for internal library use.
+ *
+ * Terms are calculated again only when t_fine differs from the one they were calculated for, so samples with
+ * unchanged temperature need the adc dependent part of compensation only.
+ * @{
+ */
+struct BME280_tfine_memo {
+
+#ifdef USE_64BIT
+	BME280_S64_t p_var1;	///< divisor of pressure compensation
+	BME280_S64_t p_var2;	///< offset of pressure compensation
+#else
+	BME280_S32_t p_var1;	///< divisor of pressure compensation
+	BME280_S32_t p_var2;	///< offset of pressure compensation
+#endif
+	BME280_S32_t h_var4;	///< dig_H5 term of humidity compensation
+	BME280_S32_t h_var2;	///< dig_H6, dig_H3 and dig_H2 terms of humidity compensation
+	BME280_S32_t t_fine_p;	///< t_fine of stored pressure terms
+	BME280_S32_t t_fine_h;	///< t_fine of stored humidity terms
+	uint8_t valid;			///< bit 0 - pressure terms are valid, bit 1 - humidity terms are valid
+};
+///@}
+#endif
+
+#ifdef USE_PRESS_LUT
+/**
+ * @defgroup BME280_presslut Pressure lookup table
+ * @brief Settings of pressure compensation with lookup table
+ *
+ * With #USE_PRESS_LUT pressure is compensated by linear interpolation between knots placed every
+ * 2^#BME280_PRESS_LUT_SHIFT counts of adc_P. Table keeps two sets of knots, for two t_fine values
+ * 2^#BME280_PRESS_LUT_TSHIFT apart, and pressure is interpolated between them as well, so a sample costs
+ * three multiply-adds. Sets are moved only when t_fine leaves the window between them by more than half of
+ * its width, so noise of temperature doesn't invalidate knots. Knots are compensated with full formula when
+ * they are needed for the first time after the move (up to four full compensations).
+ * Table covers adc_P from #BME280_PRESS_LUT_FIRST to #BME280_PRESS_LUT_LAST (about 300..1100 hPa in whole
+ * temperature range), values outside are compensated with full formula.
+ *
+ * Max. error against full 64-bit formula, measured with example calibration data from datasheet over
+ * -40..85 DegC and 300..1100 hPa (Examples/Linux/Benchmark/press_lut_check.c): 0.42 Pa with shift 14
+ * (41 knots), 0.11 Pa with shift 13 (81 knots), 1.65 Pa with shift 15 (21 knots). Without #USE_64BIT the
+ * 32-bit formula itself differs from 64-bit one by up to 6.8 Pa and the table by up to 9.3 Pa (shift 14).
+ * With adc_T noise of +-2 counts no full compensation is needed after the first sample (1 per sample
+ * without the table). Time of a read doesn't change on x86-64 host, gain is expected on cores without
+ * 64-bit divider. Shift must be in range 10..16.
+ * @{
+ */
+#ifndef BME280_PRESS_LUT_SHIFT
+#define BME280_PRESS_LUT_SHIFT	(14U)		///< distance between knots is 2^BME280_PRESS_LUT_SHIFT counts of adc_P
+#endif
+#ifndef BME280_PRESS_LUT_TSHIFT
+#define BME280_PRESS_LUT_TSHIFT	(10U)		///< distance between sets of knots is 2^BME280_PRESS_LUT_TSHIFT of t_fine (0.2 DegC)
+#endif
+#define BME280_PRESS_LUT_FIRST	(0x40000L)	///< adc_P value of first knot
+#define BME280_PRESS_LUT_LAST	(0xE0000L)	///< adc_P value of last knot
+	/// number of knots in table
+#define BME280_PRESS_LUT_KNOTS	(((BME280_PRESS_LUT_LAST - BME280_PRESS_LUT_FIRST) >> BME280_PRESS_LUT_SHIFT) + 1)
+///@}
+
+/**
+ * @struct BME280_press_lut
+ * @brief Keeps knots of pressure compensation for two t_fine values
+ * @note User should not manipulate this structure. It is only for internal library use.
+ * @{
+ */
+struct BME280_press_lut {
+
+	BME280_U32_t knots[2][BME280_PRESS_LUT_KNOTS];	///< compensated pressure at knots, for "t_fine" and next set
+	uint32_t valid[2][(BME280_PRESS_LUT_KNOTS + 31) / 32];	///< bit set if knot is compensated
+	BME280_S32_t t_fine;	///< t_fine of first set, second one is 2^#BME280_PRESS_LUT_TSHIFT higher
+};
+///@}
+#endif
+
+#ifdef USE_INVERSE
+/**
+ * @struct BME280_inverse_state
+ * @brief Keeps last results of inverse functions
+ * @note User should not manipulate this structure. It is only for internal library use.
+ *
+ * Search of next value starts from the last found one, so slowly changing values (f.e. weather traces) need
+ * two or three compensations per channel. Index 0 - temperature, 1 - pressure, 2 - humidity.
+ * @{
+ */
+struct BME280_inverse_state {
+
+	BME280_S32_t adc[3];	///< last found adc values
+	float slope[3];			///< adc counts per unit of compensated value, 0 if not known yet
+};
+///@}
+#endif
+
+#ifdef USE_STATS
+/**
+ * @struct BME280_Stats_t
+ * @brief Performance counters of single sensor
+ *
+ * Use this structure with #BME280_GetStats function. Bytes are counted as register addresses and data sent
+ * or received by user defined functions (device address and protocol overhead are not included). Compensations
+ * done by inverse functions (#BME280_InverseFrame etc.) are not counted.
+ * @{
+ */
+typedef struct {
+
+	uint32_t reads;				///< number of calls of user defined read function
+	uint32_t writes;			///< number of calls of user defined write or burst write function
+	uint32_t transfers;			///< number of calls of user defined transfer function
+	uint32_t bytes;				///< bytes transferred by all calls above
+	uint32_t interface_errors;	///< calls above which returned non-zero value
+	uint32_t busy_errors;		///< number of #BME280_BUSY_ERR results
+	uint32_t delay_ms;			///< total delay time requested from user defined delay function or transfer
+	uint32_t comp_temp;			///< number of temperature compensations
+	uint32_t comp_press;		///< number of pressure compensations with full formula
+	uint32_t comp_hum;			///< number of humidity compensations
+	uint32_t samples;			///< number of sets of results produced by read functions
+
+} BME280_Stats_t;
+///@}
+#endif
+
+#ifdef USE_LATENCY
+/**
+ * @defgroup BME280_latency Latency histograms
+ * @brief Settings of latency histograms
+ *
+ * Every histogram keeps counts of log-linear buckets (like HdrHistogram): values below 2^#BME280_LAT_SUB_BITS
+ * have own buckets, every following power of two is split into 2^#BME280_LAT_SUB_BITS buckets, so bucket width
+ * is at most 1/2^#BME280_LAT_SUB_BITS of value (12.5% with default settings). Values from
+ * 2^#BME280_LAT_MAX_BITS up are counted in the last bucket. Default settings take 176 buckets (704 bytes) per
+ * histogram.
+ * @{
+ */
+#ifndef BME280_LAT_SUB_BITS
+#define BME280_LAT_SUB_BITS		(3U)	///< number of buckets per power of two is 2^BME280_LAT_SUB_BITS
+#endif
+#ifndef BME280_LAT_MAX_BITS
+#define BME280_LAT_MAX_BITS		(24U)	///< values from 2^BME280_LAT_MAX_BITS up fall into last bucket
+#endif
+	/// number of buckets in single histogram
+#define BME280_LAT_BUCKETS		((BME280_LAT_MAX_BITS - BME280_LAT_SUB_BITS + 1) << BME280_LAT_SUB_BITS)
+///@}
+
+/**
+ * @defgroup BME280_latop Latency Operations
+ * @brief Operations with own histogram inside #BME280_Latency_t
+ * @{
+ */
+#define BME280_LAT_INIT			(0x00)	///< BME280_Init, BME280_InitWithCalib, BME280_Attach, BME280_InitForce_Q
+#define BME280_LAT_CONFIGURE	(0x01)	///< BME280_ConfigureAll, BME280_ConfigureDiff
+#define BME280_LAT_READ_FORCED	(0x02)	///< BME280_ReadxxxForce functions
+#define BME280_LAT_READ_LAST	(0x03)	///< BME280_ReadxxxLast functions and first read inside BME280_InitForce_Q
+#define BME280_LAT_COMPENSATE	(0x04)	///< BME280_CompensateTemp, BME280_CompensatePress, BME280_CompensateHum
+#define BME280_LAT_OPS			(0x05)	///< number of operations
+///@}
+
+/**
+ * @struct BME280_Hist_t
+ * @brief Latency histogram of single operation
+ * @{
+ */
+typedef struct {
+
+	uint32_t count[BME280_LAT_BUCKETS];	///< number of calls in every bucket
+	uint32_t total;						///< number of all calls
+	uint32_t max;						///< longest call
+
+} BME280_Hist_t;
+///@}
+
+/**
+ * @struct BME280_Latency_t
+ * @brief Latency histograms of all operations
+ *
+ * Structure is owned by user and connected with "latency" member of #BME280_Driver_t. It can be shared by
+ * sensors used from the same thread, every thread should use own structure. Structures can be merged with
+ * #BME280_LatencyMerge.
+ * @{
+ */
+typedef struct {
+
+	BME280_Hist_t op[BME280_LAT_OPS];	///< histogram of every operation from @ref BME280_latop
+
+} BME280_Latency_t;
+///@}
+#endif
+
 /**
  * @struct BME280_Driver_t
  * @brief Keeps all data specific for used platform
@@ -252,6 +682,20 @@ typedef struct {
 	void *env_spec_data;
 	/// (I2C only) 7-bit address on I2C bus, should be #BME280_I2CADDR_SDOL or #BME280_I2CADDR_SDOH
 	uint8_t i2c_address;
+	/// (optional) pointer to user defined function that writes several registers at once, can be NULL
+	bme280_writeburst write_burst;
+	/// (optional) pointer to user defined function that executes list of operations, can be NULL
+	bme280_transfer transfer;
+#ifdef USE_TRACE
+	/// (optional) pointer to user defined trace function, can be NULL
+	bme280_trace trace;
+#endif
+#ifdef USE_LATENCY
+	/// (optional) pointer to user defined clock function, can be NULL
+	bme280_clock clock;
+	/// (optional) pointer to histograms where latency of operations is recorded, can be NULL
+	BME280_Latency_t *latency;
+#endif
 
 } BME280_Driver_t;
 ///@}
@@ -272,6 +716,35 @@ typedef struct {
 	struct BME280_calibration_data trimm;
 	/// variable keeps result of internal temperature compensation and is used to compensate pressure and humidity
 	BME280_S32_t t_fine;
+#ifdef USE_FLOAT_COMPENSATION
+	/// structure with calibration data prepared for floating point compensation
+	struct BME280_float_calibration trimm_f;
+	/// floating point equivalent of t_fine
+	float t_fine_f;
+#endif
+
+	/// structure with copy of control registers
+	struct BME280_register_cache regs;
+#ifdef USE_TEMP_REUSE
+	/// structure with state of temperature reuse
+	struct BME280_temp_reuse t_reuse;
+#endif
+#ifdef USE_TFINE_MEMO
+	/// structure with terms of compensation calculated for last t_fine
+	struct BME280_tfine_memo memo;
+#endif
+#ifdef USE_PRESS_LUT
+	/// structure with table of pressure knots for last t_fine
+	struct BME280_press_lut p_lut;
+#endif
+#ifdef USE_STATS
+	/// structure with performance counters
+	BME280_Stats_t stats;
+#endif
+#ifdef USE_INVERSE
+	/// structure with last results of inverse functions
+	struct BME280_inverse_state inverse;
+#endif
 
 	/// variable stores current initialization status
 	uint8_t initialized;
@@ -338,6 +811,23 @@ typedef struct {
 } BME280_DataF_t;
 ///@}
 
+/**
+ * @struct BME280_DataQ_t
+ * @brief Contains result of measure in native fixed-point format (no divisions)
+ *
+ * Use this structure to read all thata from sensor at once. Values are returned exactly as compensation formulas
+ * produce them, so no division is performed by the driver. Use @ref BME280_qscale to format them when needed.
+ * @{
+ */
+typedef struct {
+
+	BME280_S32_t temp;	///< contains temperature in 0.01 deg C, f.e. contains 2137 for 21.37deg C
+	BME280_U32_t press;	///< contains pressure in 1/10000 hPa (1/100 hPa if #USE_64BIT is not set), f.e. contains 10018910 for 1001.891 hPa
+	BME280_U32_t hum;	///< contains humidity in Q22.10 format (1/1024 %), f.e. contains 50457 for 49.274 %
+
+} BME280_DataQ_t;
+///@}
+
 #endif /* BME280_DEFINITIONS_H */
 
 ///@}
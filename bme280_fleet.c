@@ -0,0 +1,433 @@
+/**
+ *******************************************
+ * @file    bme280_fleet.c
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Source code for BME280 Fleet layer
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_fleet
+ * @{
+ */
+
+//***************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bme280_fleet.h"
+
+/**
+ * @defgroup BME280_fleetpriv Private Resources
+ * @brief only for internal library purposes
+ * @{
+ */
+
+	/// check if x is null
+#define IS_NULL(x)	((NULL == x))
+
+/**
+ * @brief check if sensor can be read
+ *
+ * Function returns #BME280_OK if sensor is initialized and works in given mode
+ */
+static int8_t bme280_fleet_is_ready(BME280_t *Dev, uint8_t mode);
+
+/**
+ * @brief prepare read requests
+ *
+ * Function fills read requests of all sensors which are ready and returns number of them, results of other
+ * sensors are stored with #bme280_fleet_set_result
+ */
+static uint8_t bme280_fleet_queue(BME280_Fleet_t *Fleet, uint8_t mode, uint8_t reg_addr, uint8_t len,
+		int8_t *Results, int8_t *res, uint8_t *err_idx);
+
+/**
+ * @brief store result of single sensor
+ *
+ * Function stores result in *Results array (if not NULL) and keeps result of first failed sensor in *res
+ */
+static void bme280_fleet_set_result(int8_t *Results, uint8_t index, int8_t value, int8_t *res, uint8_t *err_idx);
+
+/**
+ * @brief group read requests by multiplexer channel
+ *
+ * Function reorders requests so the ones with the same channel are next to each other, requests of currently
+ * selected channel are placed first
+ */
+static void bme280_fleet_group(BME280_Fleet_t *Fleet, uint8_t n);
+
+/**
+ * @brief find end of channel group
+ *
+ * Function returns index of first request after group which starts at "first"
+ */
+static uint8_t bme280_fleet_group_end(BME280_Fleet_t *Fleet, uint8_t first, uint8_t n);
+
+/**
+ * @brief select multiplexer channel
+ *
+ * Function calls user defined select function only if multiplexer is used and channel is not selected yet
+ */
+static int8_t bme280_fleet_select(BME280_Fleet_t *Fleet, uint8_t channel);
+
+/**
+ * @brief read all requests
+ *
+ * Function groups requests by channel and calls #bme280_fleetread once per channel, requests of failed
+ * channels are marked with "res" = -1
+ */
+static void bme280_fleet_read(BME280_Fleet_t *Fleet, uint8_t n);
+
+/**
+ * @brief compensate single read request
+ *
+ * Function parses adc block stored at the end of *Read and compensates it into *Data
+ */
+static int8_t bme280_fleet_compensate(BME280_FleetRead_t *Read, BME280_DataQ_t *Data);
+
+/**
+ * @brief convert buffer to single variable
+ *
+ * Function converts raw adc values of temperature or pressure to single #BME280_S32_t variable
+ */
+static BME280_S32_t bme280_fleet_parse20(const uint8_t *raw);
+
+#ifdef USE_TRACE
+/**
+ * @brief report trace event
+ *
+ * Function calls trace function (if set) of every sensor from "count" read requests
+ */
+static void bme280_fleet_trace(const BME280_FleetRead_t *Reads, uint8_t count, uint8_t event, uint8_t edge);
+#endif
+///@}
+
+//***************************************
+/* public functions */
+//***************************************
+
+	/* function reads last measured values of all sensors in normal mode */
+int8_t BME280_FleetReadAllLast(BME280_Fleet_t *Fleet, BME280_DataQ_t *Data, int8_t *Results){
+
+	int8_t res = BME280_OK;
+	uint8_t i, n, err_idx = 0xFF;
+
+	/* check parameters */
+	if( IS_NULL(Fleet) || IS_NULL(Data) || IS_NULL(Fleet->devs) || IS_NULL(Fleet->reads) ||
+			IS_NULL(Fleet->read) ) return BME280_PARAM_ERR;
+	if( !IS_NULL(Fleet->channels) && IS_NULL(Fleet->select) ) return BME280_PARAM_ERR;
+
+	/* prepare read requests for sensors which are ready */
+	n = bme280_fleet_queue(Fleet, BME280_NORMALMODE, BME280_PRESS_ADC_ADDR, BME280_FLEET_RX_LEN,
+			Results, &res, &err_idx);
+	if(0 == n) return res;
+
+	/* read all of them, once per channel */
+	bme280_fleet_read(Fleet, n);
+
+	/* compensate results */
+	for(i = 0; i < n; i++){
+
+		bme280_fleet_set_result(Results, Fleet->reads[i].index,
+				bme280_fleet_compensate(&Fleet->reads[i], &Data[Fleet->reads[i].index]), &res, &err_idx);
+	}
+
+	return res;
+}
+
+#ifdef USE_FORCED_MODE
+	/* function forces single measurement of all sensors and reads results */
+int8_t BME280_FleetReadAllForce(BME280_Fleet_t *Fleet, BME280_DataQ_t *Data, int8_t *Results){
+
+	int8_t res = BME280_OK, sel, tmp;
+	uint8_t i, n, m = 0, first, last, delay, max_delay = 0, err_idx = 0xFF;
+
+	/* check parameters */
+	if( IS_NULL(Fleet) || IS_NULL(Data) || IS_NULL(Fleet->devs) || IS_NULL(Fleet->reads) ||
+			IS_NULL(Fleet->read) || IS_NULL(Fleet->delay) ) return BME280_PARAM_ERR;
+	if( !IS_NULL(Fleet->channels) && IS_NULL(Fleet->select) ) return BME280_PARAM_ERR;
+
+	/* prepare read requests for sensors which are ready, status register is read as well */
+	n = bme280_fleet_queue(Fleet, BME280_SLEEPMODE, BME280_STATUS_ADDR, BME280_FLEET_FORCED_RX_LEN,
+			Results, &res, &err_idx);
+	if(0 == n) return res;
+
+	/* trigger all sensors channel by channel, requests of failed sensors are removed */
+	bme280_fleet_group(Fleet, n);
+	for(first = 0; first < n; first = last){
+
+		last = bme280_fleet_group_end(Fleet, first, n);
+		sel = bme280_fleet_select(Fleet, Fleet->reads[first].channel);
+
+		for(i = first; i < last; i++){
+
+			/* select failure concerns whole channel */
+			tmp = sel;
+			if(BME280_OK == tmp) tmp = BME280_StartForced(Fleet->reads[i].dev, &delay);
+
+			if(BME280_OK != tmp){
+
+				bme280_fleet_set_result(Results, Fleet->reads[i].index, tmp, &res, &err_idx);
+				continue;
+			}
+
+			if(delay > max_delay) max_delay = delay;
+			if(m != i) Fleet->reads[m] = Fleet->reads[i];
+			m++;
+		}
+	}
+	if(0 == m) return res;
+
+	/* wait max. measurement time once for all sensors */
+	Fleet->delay(max_delay);
+
+	/* read all of them, last triggered channel goes first */
+	bme280_fleet_read(Fleet, m);
+
+	/* compensate results */
+	for(i = 0; i < m; i++){
+
+		bme280_fleet_set_result(Results, Fleet->reads[i].index,
+				bme280_fleet_compensate(&Fleet->reads[i], &Data[Fleet->reads[i].index]), &res, &err_idx);
+	}
+
+	return res;
+}
+#endif
+
+//***************************************
+/* static functions */
+//***************************************
+
+	/* function checks if sensor can be read */
+static int8_t bme280_fleet_is_ready(BME280_t *Dev, uint8_t mode){
+
+	if( IS_NULL(Dev) ) return BME280_PARAM_ERR;
+
+	if(0 == Dev->initialized) return BME280_NO_INIT_ERR;
+
+	if(mode != Dev->mode) return BME280_CONDITION_ERR;
+
+	return BME280_OK;
+}
+
+	/* function prepares read requests for sensors which are ready */
+static uint8_t bme280_fleet_queue(BME280_Fleet_t *Fleet, uint8_t mode, uint8_t reg_addr, uint8_t len,
+		int8_t *Results, int8_t *res, uint8_t *err_idx){
+
+	int8_t tmp;
+	uint8_t i, n = 0;
+
+	for(i = 0; i < Fleet->count; i++){
+
+		tmp = bme280_fleet_is_ready(Fleet->devs[i], mode);
+		bme280_fleet_set_result(Results, i, tmp, res, err_idx);
+		if(BME280_OK != tmp) continue;
+
+		Fleet->reads[n].dev = Fleet->devs[i];
+		Fleet->reads[n].index = i;
+		Fleet->reads[n].channel = IS_NULL(Fleet->channels) ? 0 : Fleet->channels[i];
+		Fleet->reads[n].reg_addr = reg_addr;
+		Fleet->reads[n].len = len;
+		Fleet->reads[n].frame[0] = reg_addr;
+		Fleet->reads[n].res = 0;
+		n++;
+	}
+
+	return n;
+}
+
+	/* function stores result of single sensor */
+static void bme280_fleet_set_result(int8_t *Results, uint8_t index, int8_t value, int8_t *res, uint8_t *err_idx){
+
+	if(!IS_NULL(Results)) Results[index] = value;
+
+	if( (BME280_OK != value) && (index < *err_idx) ){
+
+		*res = value;
+		*err_idx = index;
+	}
+}
+
+	/* function groups read requests by multiplexer channel, currently selected channel first */
+static void bme280_fleet_group(BME280_Fleet_t *Fleet, uint8_t n){
+
+	BME280_FleetRead_t tmp;
+	uint8_t i, first = 0, channel = Fleet->channel;
+
+	if( IS_NULL(Fleet->channels) ) return;
+
+	while(first < n){
+
+		/* move requests of "channel" to the beginning of ungrouped part */
+		for(i = first; i < n; i++){
+
+			if(channel != Fleet->reads[i].channel) continue;
+
+			if(i != first){
+
+				tmp = Fleet->reads[first];
+				Fleet->reads[first] = Fleet->reads[i];
+				Fleet->reads[i] = tmp;
+			}
+			first++;
+		}
+
+		/* next group */
+		if(first < n) channel = Fleet->reads[first].channel;
+	}
+}
+
+	/* function finds end of channel group */
+static uint8_t bme280_fleet_group_end(BME280_Fleet_t *Fleet, uint8_t first, uint8_t n){
+
+	uint8_t last = first + 1;
+
+	while( (last < n) && (Fleet->reads[last].channel == Fleet->reads[first].channel) ) last++;
+
+	return last;
+}
+
+	/* function selects multiplexer channel if needed */
+static int8_t bme280_fleet_select(BME280_Fleet_t *Fleet, uint8_t channel){
+
+	if( IS_NULL(Fleet->channels) || (channel == Fleet->channel) ) return BME280_OK;
+
+	Fleet->selects++;
+
+	if(0 != Fleet->select(channel, Fleet)){
+
+		/* state of multiplexer is unknown now */
+		Fleet->channel = BME280_FLEET_NO_CHANNEL;
+		return BME280_INTERFACE_ERR;
+	}
+
+	Fleet->channel = channel;
+
+	return BME280_OK;
+}
+
+	/* function reads all requests, once per channel */
+static void bme280_fleet_read(BME280_Fleet_t *Fleet, uint8_t n){
+
+	uint8_t i, first, last;
+
+	bme280_fleet_group(Fleet, n);
+
+	for(first = 0; first < n; first = last){
+
+		last = bme280_fleet_group_end(Fleet, first, n);
+
+		if(BME280_OK != bme280_fleet_select(Fleet, Fleet->reads[first].channel)){
+
+			for(i = first; i < last; i++) Fleet->reads[i].res = -1;
+			continue;
+		}
+
+#ifdef USE_TRACE
+		bme280_fleet_trace(&Fleet->reads[first], last - first, BME280_TRACE_BURST_READ, BME280_TRACE_BEGIN);
+#endif
+		if(0 != Fleet->read(&Fleet->reads[first], last - first, Fleet)){
+
+			for(i = first; i < last; i++) Fleet->reads[i].res = -1;
+		}
+#ifdef USE_TRACE
+		bme280_fleet_trace(&Fleet->reads[first], last - first, BME280_TRACE_BURST_READ, BME280_TRACE_END);
+#endif
+#ifdef USE_STATS
+		/* batch reads are counted per sensor, like single reads of driver (not selected sensors are not read) */
+		for(i = first; i < last; i++){
+
+			Fleet->reads[i].dev->stats.reads++;
+			Fleet->reads[i].dev->stats.bytes += 1U + Fleet->reads[i].len;
+			if(0 != Fleet->reads[i].res) Fleet->reads[i].dev->stats.interface_errors++;
+		}
+#endif
+
+		/* skipped channels, control registers are read (channel is still selected) only if their copy is not valid */
+		for(i = first; i < last; i++){
+
+			if(0 != Fleet->reads[i].res) continue;
+			if(BME280_OK != BME280_GetSkipped(Fleet->reads[i].dev, &Fleet->reads[i].skipped)) Fleet->reads[i].res = -1;
+		}
+	}
+}
+
+	/* function compensates single read request */
+static int8_t bme280_fleet_compensate(BME280_FleetRead_t *Read, BME280_DataQ_t *Data){
+
+	/* adc block is always at the end of read data */
+	const uint8_t *raw = &Read->frame[1 + Read->len - BME280_FLEET_RX_LEN];
+	BME280_S32_t adc_T, adc_P, adc_H;
+	BME280_DataQ_t tmp;
+
+	if(0 != Read->res) return BME280_INTERFACE_ERR;
+
+	/* check if forced measurement is finished */
+	if( (BME280_STATUS_ADDR == Read->reg_addr) && (0 != (Read->frame[1] & 0x09)) ){
+
+#ifdef USE_STATS
+		Read->dev->stats.busy_errors++;
+#endif
+		return BME280_BUSY_ERR;
+	}
+
+	adc_P = bme280_fleet_parse20(&raw[0]);
+	adc_T = bme280_fleet_parse20(&raw[BME280_PRESS_ADC_LEN]);
+	adc_H = ((BME280_S32_t)raw[BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN] << 8) |
+			(BME280_S32_t)raw[BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN + 1];
+
+	/* channels disabled with BME280_OVERSAMPLING_SKIPP are marked as not measured,
+	 * pressure and humidity cannot be compensated without temperature */
+#ifdef USE_TRACE
+	bme280_fleet_trace(Read, 1, BME280_TRACE_COMPENSATE, BME280_TRACE_BEGIN);
+#endif
+	tmp.temp = BME280_TEMP_NOT_MEASURED;
+	tmp.press = BME280_PRESS_NOT_MEASURED;
+	tmp.hum = BME280_HUM_NOT_MEASURED;
+
+	if(0 == (Read->skipped & BME280_SKIPPED_TEMP)){
+
+		/* temperature first, it sets t_fine for pressure and humidity */
+		BME280_CompensateTemp(Read->dev, adc_T, &tmp.temp);
+		if(0 == (Read->skipped & BME280_SKIPPED_PRESS)) BME280_CompensatePress(Read->dev, adc_P, &tmp.press);
+		if(0 == (Read->skipped & BME280_SKIPPED_HUM)) BME280_CompensateHum(Read->dev, adc_H, &tmp.hum);
+	}
+
+#ifdef USE_TRACE
+	bme280_fleet_trace(Read, 1, BME280_TRACE_COMPENSATE, BME280_TRACE_END);
+#endif
+
+	*Data = tmp;
+#ifdef USE_STATS
+	Read->dev->stats.samples++;
+#endif
+
+	return BME280_OK;
+}
+
+	/* function parses raw adc pressure or temp values into a single BME280_S32_t variable */
+static BME280_S32_t bme280_fleet_parse20(const uint8_t *raw){
+
+	return ((BME280_S32_t)raw[0] << 12U) | ((BME280_S32_t)raw[1] << 4U) | ((BME280_S32_t)raw[2] >> 4U);
+}
+
+#ifdef USE_TRACE
+	/* function reports trace event of several sensors */
+static void bme280_fleet_trace(const BME280_FleetRead_t *Reads, uint8_t count, uint8_t event, uint8_t edge){
+
+	uint8_t i;
+	BME280_Driver_t *drv;
+
+	for(i = 0; i < count; i++){
+
+		drv = Reads[i].dev->driver;
+		if( !IS_NULL(drv->trace) ) drv->trace(event, edge, (BME280_TRACE_BURST_READ == event) ? Reads[i].len : 0, drv);
+	}
+}
+#endif
+
+///@}
@@ -0,0 +1,202 @@
+/**
+ *******************************************
+ * @file    bme280_fleet.h
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Header for BME280 Fleet layer
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_Driver
+ * @{
+ */
+
+//***************************************
+
+#ifndef BME280_FLEET_H
+#define BME280_FLEET_H
+
+//***************************************
+
+#ifdef __cplusplus /* CPP */
+extern "C" {
+#endif
+
+//***************************************
+
+#include <stdint.h>
+#include "bme280.h"
+
+#ifndef USE_FIXED_RESULTS
+#error "bme280_fleet.h requires USE_FIXED_RESULTS in bme280.h"
+#endif
+
+/**
+ * @defgroup BME280_fleet Fleet
+ * @brief Read many sensors with single batch transfer
+ *
+ * Fleet layer groups adc reads of many initialized sensors into one call of user defined #bme280_fleetread
+ * function, so platform can send them as single transfer (f.e. one I2C_RDWR ioctl with many messages on Linux).
+ * Results are compensated with @ref BME280_compq functions. Sensors are still initialized and configured with
+ * functions from bme280.h, each one with its own #BME280_Driver_t structure.
+ *
+ * Sensors placed behind I2C multiplexers (f.e. TCA9548A) are supported with "channels" and "select" members of
+ * #BME280_Fleet_t. Requests are grouped by channel, so every channel is selected once per pass and the channel
+ * selected last is reused by the next pass. Number of select writes is counted in "selects" member.
+ * @note bme280_fleet.c must be compiled together with bme280.c, #USE_FIXED_RESULTS is required
+ * @{
+ */
+
+/**
+ * @defgroup BME280_fleetdefs Definitions
+ * @{
+ */
+	/// lenght of adc block read from every sensor (pressure, temperature, humidity)
+#define BME280_FLEET_RX_LEN		(BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN + BME280_HUM_ADC_LEN)
+
+	/// lenght of block read from every sensor after forced measurement (status, ctrl_meas, config, reserved, adc)
+#define BME280_FLEET_FORCED_RX_LEN	(4U + BME280_FLEET_RX_LEN)
+
+	/// lenght of frame inside #BME280_FleetRead_t (register address + longest block)
+#define BME280_FLEET_FRAME_LEN	(1U + BME280_FLEET_FORCED_RX_LEN)
+
+	/// value of "channel" member of #BME280_Fleet_t when selected channel of multiplexer is unknown
+#define BME280_FLEET_NO_CHANNEL	(0xFFU)
+///@}
+
+/**
+ * @struct BME280_FleetRead_t
+ * @brief Single read request passed to #bme280_fleetread function
+ *
+ * frame[0] contains register address and read data must be stored from frame[1], so the frame can be used
+ * directly as tx and rx buffer of single full duplex SPI transfer (len + 1 bytes, MSB of frame[0] must be set
+ * by platform function), or frame[0] as I2C write message and &frame[1] as I2C read message.
+ * @{
+ */
+typedef struct {
+
+	BME280_t *dev;		///< sensor to read from, platform data are in dev->driver
+	uint8_t index;		///< position of sensor in #BME280_Fleet_t, for internal use
+	uint8_t channel;	///< multiplexer channel of sensor (0 if "channels" member of #BME280_Fleet_t is NULL)
+	uint8_t reg_addr;	///< address of first register to read
+	uint8_t len;		///< lenght of data to read (in bytes)
+	uint8_t frame[BME280_FLEET_FRAME_LEN];	///< register address followed by buffer where data must be stored
+	int8_t res;			///< result of this read set by #bme280_fleetread, 0 - success, -1 - failure
+	uint8_t skipped;	///< channels disabled by oversampling (@ref BME280_Skipped), for internal use
+
+} BME280_FleetRead_t;
+///@}
+
+/**
+ * Function to read registers of several sensors at once.
+ *
+ * Function must perform all "count" reads, each one like #bme280_readregisters, and set "res" member of every
+ * request. Reads can be merged into as few bus transfers as platform allows (f.e. one I2C_RDWR ioctl). Linux
+ * spidev gives no such merge: every sensor needs its own chip select, and so its own device node and ioctl.
+ * If multiplexer is used, all requests passed in single call have the same "channel" and this channel is
+ * already selected.
+ * @param[in,out] *reads pointer to array of read requests
+ * @param[in] count number of requests
+ * @param[in] *fleet pointer to #BME280_Fleet_t structure
+ * @return 0 success (results of single reads are in "res" members)
+ * @return -1 failure of whole batch
+ */
+typedef int8_t (*bme280_fleetread)(BME280_FleetRead_t *reads, uint8_t count, void *fleet);
+
+/**
+ * Function to select channel of I2C multiplexer.
+ *
+ * Function must connect sensors of given channel to the bus (f.e. write (1 << channel) to TCA9548A control
+ * register) and disconnect all others, so sensors with the same I2C address at different channels don't collide.
+ * @param[in] channel channel to select, value from "channels" member of #BME280_Fleet_t
+ * @param[in] *fleet pointer to #BME280_Fleet_t structure
+ * @return 0 success
+ * @return -1 failure
+ */
+typedef int8_t (*bme280_fleetselect)(uint8_t channel, void *fleet);
+
+/**
+ * @struct BME280_Fleet_t
+ * @brief Keeps group of sensors read together
+ * @{
+ */
+typedef struct {
+
+	/// array of pointers to sensors, each one initialized with #BME280_Init before
+	BME280_t **devs;
+	/// working array with at least "count" elements, for internal use
+	BME280_FleetRead_t *reads;
+	/// number of sensors
+	uint8_t count;
+	/// pointer to user defined function that reads several sensors at once
+	bme280_fleetread read;
+	/// pointer to platform specific data (f.e. file descriptor of i2c adapter)
+	void *env_spec_data;
+	/// array of "count" multiplexer channels of sensors, NULL if multiplexer is not used
+	const uint8_t *channels;
+	/// pointer to user defined function that selects multiplexer channel, required if "channels" is not NULL
+	bme280_fleetselect select;
+	/// currently selected channel, set to #BME280_FLEET_NO_CHANNEL before first use
+	uint8_t channel;
+	/// number of channel select writes done so far, can be cleared by user
+	uint32_t selects;
+#ifdef USE_FORCED_MODE
+	/// pointer to user defined delay function, required by #BME280_FleetReadAllForce
+	bme280_delayms delay;
+#endif
+
+} BME280_Fleet_t;
+///@}
+
+/**
+ * @brief Function reads last measured values of all sensors in normal mode
+ *
+ * Function reads adc registers of all sensors which are in #BME280_NORMALMODE with single call of
+ * #bme280_fleetread function, then compensates them. Sensors which are not ready are skipped.
+ * @param[in] *Fleet pointer to #BME280_Fleet_t structure
+ * @param[out] *Data pointer to array of "count" structures where results will be stored, elements of sensors
+ * which were not read successfully are not changed
+ * @param[out] *Results pointer to array of "count" results of every sensor (values like returned by
+ * #BME280_ReadAllLast_Q), can be NULL
+ * @return #BME280_OK all sensors were read successfully
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined function returned non-zero value for whole batch or channel select
+ * @return result of first sensor which was not read successfully
+ */
+int8_t BME280_FleetReadAllLast(BME280_Fleet_t *Fleet, BME280_DataQ_t *Data, int8_t *Results);
+
+#ifdef USE_FORCED_MODE
+/**
+ * @brief Function forces single measurement of all sensors and reads results
+ *
+ * Function starts measurement of all sensors which are in #BME280_SLEEPMODE channel by channel, waits max.
+ * measurement time once, then reads all channels in reverse order (last triggered channel is still selected).
+ * With k channels in use it takes 2k - 1 select writes in total (or 2k - 2 if first channel is already
+ * selected). Sensors which are not ready are skipped.
+ * @param[in] *Fleet pointer to #BME280_Fleet_t structure
+ * @param[out] *Data pointer to array of "count" structures where results will be stored, elements of sensors
+ * which were not read successfully are not changed
+ * @param[out] *Results pointer to array of "count" results of every sensor (values like returned by
+ * #BME280_ReadAllForce_Q), can be NULL
+ * @return #BME280_OK all sensors were read successfully
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ * @return #BME280_INTERFACE_ERR user defined function returned non-zero value for whole batch or channel select
+ * @return result of first sensor which was not read successfully
+ */
+int8_t BME280_FleetReadAllForce(BME280_Fleet_t *Fleet, BME280_DataQ_t *Data, int8_t *Results);
+#endif
+///@}
+
+//***************************************
+
+#ifdef __cplusplus /* CPP */
+}
+#endif
+
+//***************************************
+
+#endif /* BME280_FLEET_H */
+
+///@}
@@ -0,0 +1,246 @@
+/**
+ *******************************************
+ * @file    bme280_plan.c
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Source code for BME280 capacity planner
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_plan
+ * @{
+ */
+
+//***************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bme280_plan.h"
+
+/**
+ * @defgroup BME280_planpriv Private Resources
+ * @brief only for internal library purposes
+ * @{
+ */
+
+	/// check if x is null
+#define IS_NULL(x)	((NULL == x))
+
+	/// lenght of block read by #BME280_FleetReadAllForce from every sensor (status, ctrl_meas, config, reserved, adc)
+#define BME280_PLAN_FLEET_FORCED_LEN	(4U + BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN + BME280_HUM_ADC_LEN)
+
+	/// lenght of all adc registers
+#define BME280_PLAN_ADC_LEN		(BME280_PRESS_ADC_LEN + BME280_TEMP_ADC_LEN + BME280_HUM_ADC_LEN)
+
+	/// standby times of normal mode in us, index is value of @ref BME280_tstby
+static const uint32_t bme280_plan_stby_us[8] = { 500UL, 62500UL, 125000UL, 250000UL, 500000UL, 1000000UL,
+		10000UL, 20000UL };
+
+/**
+ * @brief calculate energy per sample
+ *
+ * Function calculates energy used by single sensor per sample (in nJ), when samples are taken every
+ * "period" us
+ */
+static uint32_t bme280_plan_energy(const BME280_PlanBus_t *Bus, uint32_t period);
+
+/**
+ * @brief transaction time in microseconds
+ *
+ * Function converts time of transaction in nanoseconds to microseconds (rounded up)
+ */
+static uint32_t bme280_plan_us(uint32_t ns);
+
+/**
+ * @brief scaled multiplication
+ *
+ * Function returns a * b / 1000 without overflow of 32-bit variables for b below 4294967
+ */
+static uint32_t bme280_plan_scale(uint32_t a, uint32_t b);
+///@}
+
+//***************************************
+/* public functions */
+//***************************************
+
+	/* function calculates plan of single bus */
+int8_t BME280_PlanBus(const BME280_PlanBus_t *Bus, BME280_Plan_t *Plan){
+
+	int8_t res;
+	uint32_t meas, write = 0, status = 0, adc = 0, select = 0, overhead = 0, sensor, target;
+	uint8_t len = BME280_PLAN_ADC_LEN, channels;
+
+	/* check parameters */
+	if( IS_NULL(Bus) || IS_NULL(Plan) ) return BME280_PARAM_ERR;
+	if( (0 == Bus->sensors) || (0 == Bus->vdd_mv) || (Bus->osrs_t > 0x07) || (Bus->osrs_p > 0x07) ||
+			(Bus->osrs_h > 0x07) || (Bus->t_stby > BME280_STBY_20MS) ) return BME280_PARAM_ERR;
+	if( (BME280_FORCEDMODE != Bus->mode) && (BME280_NORMALMODE != Bus->mode) ) return BME280_PARAM_ERR;
+	if(Bus->channels > Bus->sensors) return BME280_PARAM_ERR;
+
+	/* max. measurement time, the same as waited by the driver */
+	meas = BME280_MEAS_TIME_MS(Bus->osrs_t, Bus->osrs_p, Bus->osrs_h) * 1000UL;
+
+	/* channel select of multiplexer is single byte write, counted as single register write */
+	channels = (Bus->channels > 1U) ? Bus->channels : 1U;
+	if(channels > 1U){
+
+		res = BME280_BusTimeWrite(&Bus->bus, 1, &select);
+		if(BME280_OK != res) return res;
+		select = bme280_plan_us(select);
+	}
+
+	/* single sensor reads skip disabled channels, fleet layer reads all adc registers */
+	if(0 == Bus->batched){
+
+		if(BME280_OVERSAMPLING_SKIPP == Bus->osrs_p) len -= BME280_PRESS_ADC_LEN;
+		if(BME280_OVERSAMPLING_SKIPP == Bus->osrs_h) len -= BME280_HUM_ADC_LEN;
+	}
+	else{
+
+		/* fleet layer calls platform function once per channel, not once per sensor */
+		overhead = bme280_plan_us(Bus->bus.overhead_ns);
+		if(BME280_FORCEDMODE == Bus->mode) len = BME280_PLAN_FLEET_FORCED_LEN;
+	}
+
+	/* read of every sensor, wire time only if fleet layer is used */
+	res = BME280_BusTimeRead(&Bus->bus, len, &adc);
+	if(BME280_OK != res) return res;
+	if(0 != Bus->batched) adc -= Bus->bus.overhead_ns;
+	adc = bme280_plan_us(adc);
+
+	if(BME280_FORCEDMODE == Bus->mode){
+
+		/* write of ctrl_meas */
+		res = BME280_BusTimeWrite(&Bus->bus, 1, &write);
+		if(BME280_OK != res) return res;
+		write = bme280_plan_us(write);
+
+		if(0 != Bus->batched){
+
+			/* all sensors are triggered channel by channel, then read with status after single wait, last
+			 * triggered channel first */
+			Plan->busy_us = (Bus->sensors * (write + adc)) + (channels * overhead);
+			if(channels > 1U) Plan->busy_us += ((2U * channels) - 1U) * select;
+			Plan->period_us = Plan->busy_us + meas;
+			Plan->skew_us = ((Bus->sensors - 1U) * write) + ((channels - 1U) * select);
+		}
+		else{
+
+			/* every sensor is triggered, waited for and read (ctrl_hum, status, ctrl_meas and adc) before the
+			 * next one */
+			res = BME280_BusTimeRead(&Bus->bus, 3, &status);
+			if(BME280_OK != res) return res;
+			adc += bme280_plan_us(status);
+
+			Plan->busy_us = Bus->sensors * (write + adc);
+			if(channels > 1U) Plan->busy_us += channels * select;
+			Plan->period_us = Plan->busy_us + (Bus->sensors * meas);
+			Plan->skew_us = ((Bus->sensors - 1U) * (write + meas + adc)) + ((channels - 1U) * select);
+		}
+	}
+	else{
+
+		/* sensors measure by themselves, adc registers are read only */
+		Plan->busy_us = (Bus->sensors * adc) + (channels * overhead);
+		if(channels > 1U) Plan->busy_us += channels * select;
+
+		/* sensors are not synchronized, so the oldest result can be one period of sensor older */
+		sensor = meas + bme280_plan_stby_us[Bus->t_stby];
+		Plan->period_us = (Plan->busy_us > sensor) ? Plan->busy_us : sensor;
+		Plan->skew_us = sensor + ((Bus->sensors - 1U) * adc) + ((channels - 1U) * (select + overhead));
+	}
+
+	/* achievable rate of every sensor */
+	Plan->rate_mhz = 1000000000UL / Plan->period_us;
+	if(0 == Plan->rate_mhz) Plan->rate_mhz = 1;
+
+	/* target rate, limited to achievable one */
+	target = (0 == Bus->rate_mhz) ? Plan->rate_mhz : Bus->rate_mhz;
+	Plan->oversubscribed = (target > Plan->rate_mhz) ? 1 : 0;
+	if(target > Plan->rate_mhz) target = Plan->rate_mhz;
+	target = 1000000000UL / target;
+
+	/* busy time is never longer than period */
+	if(Plan->busy_us < 429496UL) Plan->utilization = (Plan->busy_us * 10000UL) / target;
+	else Plan->utilization = Plan->busy_us / (target / 10000UL);
+
+	Plan->energy_nj = bme280_plan_energy(Bus, target);
+
+	return BME280_OK;
+}
+
+	/* function calculates plans of several buses */
+int8_t BME280_PlanFleet(const BME280_PlanBus_t *Buses, uint8_t Count, BME280_Plan_t *Plans,
+		uint8_t *Oversubscribed){
+
+	int8_t res;
+	uint8_t i, over = 0;
+
+	/* check parameters */
+	if( IS_NULL(Buses) || IS_NULL(Plans) ) return BME280_PARAM_ERR;
+
+	for(i = 0; i < Count; i++){
+
+		res = BME280_PlanBus(&Buses[i], &Plans[i]);
+		if(BME280_OK != res) return res;
+
+		over += Plans[i].oversubscribed;
+	}
+
+	if(!IS_NULL(Oversubscribed)) *Oversubscribed = over;
+
+	return BME280_OK;
+}
+
+//***************************************
+/* static functions */
+//***************************************
+
+	/* function calculates energy used by single sensor per sample */
+static uint32_t bme280_plan_energy(const BME280_PlanBus_t *Bus, uint32_t period){
+
+	uint32_t t, p = 0, h = 0, active, charge, cycle, energy, n;
+
+	/* phases of measurement in 10us units, like in BME280_MEAS_TIME_MS (startup is counted as temperature) */
+	t = 125U + (230U * BME280_OSRS_TO_OVS(Bus->osrs_t));
+	if(BME280_OVERSAMPLING_SKIPP != Bus->osrs_p) p = (230U * BME280_OSRS_TO_OVS(Bus->osrs_p)) + 58U;
+	if(BME280_OVERSAMPLING_SKIPP != Bus->osrs_h) h = (230U * BME280_OSRS_TO_OVS(Bus->osrs_h)) + 58U;
+
+	/* charge of measurement in pC (uA * 10us = 10pC) */
+	active = (t + p + h) * 10U;
+	charge = ((BME280_PLAN_IDD_T_UA * t) + (BME280_PLAN_IDD_P_UA * p) + (BME280_PLAN_IDD_H_UA * h)) * 10U;
+
+	/* forced mode: sensor sleeps between samples */
+	if(BME280_FORCEDMODE == Bus->mode){
+
+		if(period > active) charge += bme280_plan_scale(period - active, BME280_PLAN_IDD_SLEEP_NA);
+		return bme280_plan_scale(charge, Bus->vdd_mv) / 1000U;
+	}
+
+	/* normal mode: sensor measures every cycle, even if not every result is read */
+	cycle = (BME280_MEAS_TIME_MS(Bus->osrs_t, Bus->osrs_p, Bus->osrs_h) * 1000UL) + bme280_plan_stby_us[Bus->t_stby];
+	charge += bme280_plan_scale(cycle - active, BME280_PLAN_IDD_STBY_NA);
+	energy = bme280_plan_scale(charge, Bus->vdd_mv) / 1000U;
+
+	/* energy of full cycles and fraction of the last one (in 0.1%) */
+	n = period / cycle;
+	if( (0 != n) && (energy > (UINT32_MAX / n)) ) return UINT32_MAX;
+
+	return (energy * n) + bme280_plan_scale(energy, ((period % cycle) * 1000UL) / cycle);
+}
+
+	/* function converts transaction time to microseconds */
+static uint32_t bme280_plan_us(uint32_t ns){
+
+	return (ns / 1000UL) + ((0 != (ns % 1000UL)) ? 1U : 0U);
+}
+
+	/* function multiplies a and b and divides by 1000 */
+static uint32_t bme280_plan_scale(uint32_t a, uint32_t b){
+
+	return ((a / 1000UL) * b) + (((a % 1000UL) * b) / 1000UL);
+}
+
+///@}
@@ -0,0 +1,180 @@
+/**
+ *******************************************
+ * @file    bme280_plan.h
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Header for BME280 capacity planner
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_Driver
+ * @{
+ */
+
+//***************************************
+
+#ifndef BME280_PLAN_H
+#define BME280_PLAN_H
+
+//***************************************
+
+#ifdef __cplusplus /* CPP */
+extern "C" {
+#endif
+
+//***************************************
+
+#include <stdint.h>
+#include "bme280.h"
+#include "bme280_record.h"
+
+/**
+ * @defgroup BME280_plan Capacity Planner
+ * @brief Estimate how many sensors a bus can serve
+ *
+ * Planner takes description of every bus (type and clock, number of sensors, mode, oversampling, target rate)
+ * and calculates bus time of single pass (every sensor read once), achievable rate, bus utilization, worst-case
+ * skew between sensors and energy per sample, and marks buses which can't reach target rate. Transactions are
+ * the same as issued by the driver in steady state (control registers cached):
+ * - forced mode, sensors one by one (#BME280_ReadAllForce_Q): write of ctrl_meas, wait of max. measurement
+ * time, read of ctrl_hum, status and ctrl_meas and read of measured adc channels, next sensor is started after
+ * previous one is read
+ * - forced mode, fleet layer (#BME280_FleetReadAllForce): write of ctrl_meas to every sensor, single wait, read
+ * of status and all adc registers from every sensor
+ * - normal mode (#BME280_ReadAllLast_Q or #BME280_FleetReadAllLast): read of adc registers from every sensor,
+ * sensors measure by themselves every max. measurement time + standby time
+ *
+ * Overhead of platform function is added to every call of it: to every transaction of sensors read one by one,
+ * but only once per channel to reads of fleet layer (single call of #bme280_fleetread per channel). Sensors
+ * behind multiplexer are read channel by channel, every channel change costs one select write (counted as
+ * single register write): 2k - 1 writes per pass of #BME280_FleetReadAllForce (k - channels), k writes
+ * otherwise.
+ *
+ * Wait time is calculated with #BME280_MEAS_TIME_MS like in the driver, time of every transaction with
+ * #BME280_BusTimeRead and #BME280_BusTimeWrite, so the plan follows the driver and the replay timing model.
+ * Energy is energy of sensor only (measurement currents of datasheet and sleep or standby current between
+ * samples), energy of bus is not included.
+ * @note bme280_plan.c must be compiled together with bme280_record.c (bme280.c is not needed), #USE_STATIC_BUS
+ * can't be used
+ * @{
+ */
+
+/**
+ * @defgroup BME280_plandefs Definitions
+ * @brief Typical supply currents of datasheet, can be defined before to use other values
+ * @{
+ */
+#ifndef BME280_PLAN_IDD_T_UA
+#define BME280_PLAN_IDD_T_UA	(350U)	///< current during temperature measurement (in uA)
+#endif
+#ifndef BME280_PLAN_IDD_P_UA
+#define BME280_PLAN_IDD_P_UA	(714U)	///< current during pressure measurement (in uA)
+#endif
+#ifndef BME280_PLAN_IDD_H_UA
+#define BME280_PLAN_IDD_H_UA	(340U)	///< current during humidity measurement (in uA)
+#endif
+#ifndef BME280_PLAN_IDD_SLEEP_NA
+#define BME280_PLAN_IDD_SLEEP_NA	(100U)	///< current in sleep mode (in nA)
+#endif
+#ifndef BME280_PLAN_IDD_STBY_NA
+#define BME280_PLAN_IDD_STBY_NA	(200U)	///< current in standby time of normal mode (in nA)
+#endif
+///@}
+
+/**
+ * @struct BME280_PlanBus_t
+ * @brief Description of single bus
+ * @{
+ */
+typedef struct {
+
+	/// bus type, clock and overhead of platform function
+	BME280_BusTiming_t bus;
+	/// number of sensors connected to the bus
+	uint8_t sensors;
+	/// #BME280_FORCEDMODE or #BME280_NORMALMODE
+	uint8_t mode;
+	/// temperature oversampling, value of @ref BME280_Ovs
+	uint8_t osrs_t;
+	/// pressure oversampling, value of @ref BME280_Ovs
+	uint8_t osrs_p;
+	/// humidity oversampling, value of @ref BME280_Ovs
+	uint8_t osrs_h;
+	/// standby time in normal mode, value of @ref BME280_tstby (not used in forced mode)
+	uint8_t t_stby;
+	/// 0 - sensors are read one by one, 1 - sensors are read together with fleet layer (one platform call per
+	/// channel, f.e. I2C_RDWR ioctl; Linux spidev still needs one ioctl per sensor, see Examples/Linux/SPI_Fleet)
+	uint8_t batched;
+	/// number of multiplexer channels the sensors are spread over, 0 or 1 - no multiplexer
+	uint8_t channels;
+	/// target rate of every sensor in mHz, 0 - as fast as possible
+	uint32_t rate_mhz;
+	/// supply voltage of sensors in mV
+	uint16_t vdd_mv;
+
+} BME280_PlanBus_t;
+///@}
+
+/**
+ * @struct BME280_Plan_t
+ * @brief Results calculated for single bus
+ * @{
+ */
+typedef struct {
+
+	/// bus time of single pass, every sensor read once (in us)
+	uint32_t busy_us;
+	/// min. time of single pass (in us), limited by bus, measurement time or period of normal mode
+	uint32_t period_us;
+	/// achievable rate of every sensor (in mHz)
+	uint32_t rate_mhz;
+	/// bus utilization at target rate (or achievable rate if lower), in 0.01%
+	uint32_t utilization;
+	/// worst-case time between samples of first and last sensor taken in single pass (in us)
+	uint32_t skew_us;
+	/// energy used by single sensor per sample at target rate (or achievable rate if lower), in nJ
+	uint32_t energy_nj;
+	/// 1 if target rate is higher than achievable rate, 0 otherwise
+	uint8_t oversubscribed;
+
+} BME280_Plan_t;
+///@}
+
+/**
+ * @brief Function calculates plan of single bus
+ * @param[in] *Bus pointer to description of bus
+ * @param[out] *Plan pointer to structure where results will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed (no sensors, more channels than sensors, wrong mode,
+ * oversampling, standby time, supply voltage or clock frequency)
+ */
+int8_t BME280_PlanBus(const BME280_PlanBus_t *Bus, BME280_Plan_t *Plan);
+
+/**
+ * @brief Function calculates plans of several buses
+ * @param[in] *Buses pointer to array of "Count" descriptions of buses
+ * @param[in] Count number of buses
+ * @param[out] *Plans pointer to array of "Count" structures where results will be stored
+ * @param[out] *Oversubscribed pointer to variable where number of oversubscribed buses will be stored,
+ * can be NULL
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed, or description of any bus is wrong (plans of buses before
+ * are stored)
+ */
+int8_t BME280_PlanFleet(const BME280_PlanBus_t *Buses, uint8_t Count, BME280_Plan_t *Plans,
+		uint8_t *Oversubscribed);
+///@}
+
+//***************************************
+
+#ifdef __cplusplus /* CPP */
+}
+#endif
+
+//***************************************
+
+#endif /* BME280_PLAN_H */
+
+///@}
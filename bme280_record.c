@@ -0,0 +1,478 @@
+/**
+ *******************************************
+ * @file    bme280_record.c
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Source code for BME280 bus recorder and replay
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_record
+ * @{
+ */
+
+//***************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "bme280_record.h"
+
+/**
+ * @defgroup BME280_recpriv Private Resources
+ * @brief only for internal library purposes
+ * @{
+ */
+
+	/// check if x is null
+#define IS_NULL(x)	((NULL == x))
+
+/**
+ * @brief append record
+ *
+ * Function stores single record in trace buffer, or counts it as dropped if it doesn't fit
+ */
+static void bme280_rec_append(BME280_Recorder_t *Rec, uint8_t type, uint8_t reg_addr, const uint8_t *data,
+		uint8_t len, int8_t res);
+
+/**
+ * @brief take next record
+ *
+ * Function returns pointer to next record of given type, register and lenght and moves to the one after it,
+ * or returns NULL and counts mismatch if trace is different
+ */
+static const uint8_t *bme280_rep_next(BME280_Replay_t *Rep, uint8_t type, uint8_t reg_addr, uint8_t len);
+
+/**
+ * @brief recorder functions
+ *
+ * Functions call functions of real driver and record their data, see @ref BME280_prots
+ */
+static int8_t bme280_rec_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+static int8_t bme280_rec_write(uint8_t reg_addr, uint8_t value, void *driver);
+static int8_t bme280_rec_write_burst(const uint8_t *pairs, uint8_t count, void *driver);
+static int8_t bme280_rec_transfer(const BME280_Op_t *ops, uint8_t count, void *driver);
+
+/**
+ * @brief replay single read or write
+ *
+ * Functions serve single read or write from recorded trace, without simulated time
+ */
+static int8_t bme280_rep_read_op(BME280_Replay_t *Rep, uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen);
+static int8_t bme280_rep_write_op(BME280_Replay_t *Rep, uint8_t reg_addr, uint8_t value);
+
+/**
+ * @brief charge simulated time
+ *
+ * Function adds wire time of single transaction to replay, with overhead of platform function if "overhead"
+ * is set
+ */
+static void bme280_rep_charge(BME280_Replay_t *Rep, uint8_t write, uint8_t n, uint8_t overhead);
+
+/**
+ * @brief replay functions
+ *
+ * Functions serve data from recorded trace, see @ref BME280_prots
+ */
+static int8_t bme280_rep_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver);
+static int8_t bme280_rep_write(uint8_t reg_addr, uint8_t value, void *driver);
+static int8_t bme280_rep_write_burst(const uint8_t *pairs, uint8_t count, void *driver);
+static int8_t bme280_rep_transfer(const BME280_Op_t *ops, uint8_t count, void *driver);
+static void bme280_rep_delay(uint8_t delay_time);
+
+/**
+ * @brief wire time of transaction
+ *
+ * Function calculates time of transaction with "bytes" bytes on the bus (in nanoseconds, without overhead of
+ * platform function), "restart" is set for I2C reads
+ */
+static int8_t bme280_bus_time(const BME280_BusTiming_t *Bus, uint32_t bytes, uint8_t restart, uint32_t *Time);
+///@}
+
+//***************************************
+/* public functions */
+//***************************************
+
+	/* function prepares recorder */
+int8_t BME280_RecorderInit(BME280_Recorder_t *Rec, BME280_Driver_t *Driver, BME280_Driver_t *Target,
+		uint8_t *Buff, uint32_t Size){
+
+	/* check parameters */
+	if( IS_NULL(Rec) || IS_NULL(Driver) || IS_NULL(Target) || IS_NULL(Buff) ) return BME280_PARAM_ERR;
+	if( IS_NULL(Target->read) || IS_NULL(Target->write) || (Size < BME280_REC_HEADER_LEN) ) return BME280_PARAM_ERR;
+
+	/* trace header */
+	Buff[0] = (uint8_t)BME280_REC_MAGIC;
+	Buff[1] = (uint8_t)(BME280_REC_MAGIC >> 8);
+	Buff[2] = (uint8_t)(BME280_REC_MAGIC >> 16);
+	Buff[3] = (uint8_t)(BME280_REC_MAGIC >> 24);
+	Buff[4] = BME280_REC_VERSION;
+
+	Rec->target = Target;
+	Rec->buff = Buff;
+	Rec->size = Size;
+	Rec->len = BME280_REC_HEADER_LEN;
+	Rec->dropped = 0;
+
+	/* driver calls recorder, recorder calls real driver */
+	*Driver = *Target;
+	Driver->read = bme280_rec_read;
+	Driver->write = bme280_rec_write;
+	Driver->write_burst = IS_NULL(Target->write_burst) ? NULL : bme280_rec_write_burst;
+	Driver->transfer = IS_NULL(Target->transfer) ? NULL : bme280_rec_transfer;
+	Driver->env_spec_data = Rec;
+
+	return BME280_OK;
+}
+
+	/* function prepares replay */
+int8_t BME280_ReplayInit(BME280_Replay_t *Rep, BME280_Driver_t *Driver, const uint8_t *Buff, uint32_t Len){
+
+	/* check parameters */
+	if( IS_NULL(Rep) || IS_NULL(Driver) || IS_NULL(Buff) || (Len < BME280_REC_HEADER_LEN) ) return BME280_PARAM_ERR;
+
+	/* check trace header */
+	if( (Buff[0] != (uint8_t)BME280_REC_MAGIC) || (Buff[1] != (uint8_t)(BME280_REC_MAGIC >> 8)) ||
+			(Buff[2] != (uint8_t)(BME280_REC_MAGIC >> 16)) || (Buff[3] != (uint8_t)(BME280_REC_MAGIC >> 24)) ||
+			(Buff[4] != BME280_REC_VERSION) ) return BME280_PARAM_ERR;
+
+	Rep->buff = Buff;
+	Rep->len = Len;
+	Rep->pos = BME280_REC_HEADER_LEN;
+	Rep->mismatches = 0;
+	Rep->bus = NULL;
+	Rep->bus_ms = 0;
+	Rep->bus_ns = 0;
+	Rep->wait_ms = 0;
+
+	memset(Driver, 0, sizeof(BME280_Driver_t));
+	Driver->read = bme280_rep_read;
+	Driver->write = bme280_rep_write;
+	Driver->write_burst = bme280_rep_write_burst;
+	Driver->transfer = bme280_rep_transfer;
+	Driver->delay = bme280_rep_delay;
+	Driver->env_spec_data = Rep;
+
+	return BME280_OK;
+}
+
+	/* function calculates time of register read */
+int8_t BME280_BusTimeRead(const BME280_BusTiming_t *Bus, uint8_t Len, uint32_t *Time){
+
+	int8_t res;
+
+	/* check parameters */
+	if( IS_NULL(Bus) || IS_NULL(Time) ) return BME280_PARAM_ERR;
+
+	/* I2C: address, register, address again and data, SPI: register and data */
+	if(BME280_BUS_I2C == Bus->type) res = bme280_bus_time(Bus, 3U + Len, 1, Time);
+	else res = bme280_bus_time(Bus, 1U + Len, 0, Time);
+
+	if(BME280_OK == res) *Time += Bus->overhead_ns;
+	return res;
+}
+
+	/* function calculates time of register write */
+int8_t BME280_BusTimeWrite(const BME280_BusTiming_t *Bus, uint8_t Count, uint32_t *Time){
+
+	int8_t res;
+
+	/* check parameters */
+	if( IS_NULL(Bus) || IS_NULL(Time) ) return BME280_PARAM_ERR;
+
+	/* I2C: address and pairs, SPI: pairs only */
+	if(BME280_BUS_I2C == Bus->type) res = bme280_bus_time(Bus, 1U + (2U * Count), 0, Time);
+	else res = bme280_bus_time(Bus, 2U * Count, 0, Time);
+
+	if(BME280_OK == res) *Time += Bus->overhead_ns;
+	return res;
+}
+
+//***************************************
+/* static functions */
+//***************************************
+
+	/* function stores single record in trace buffer */
+static void bme280_rec_append(BME280_Recorder_t *Rec, uint8_t type, uint8_t reg_addr, const uint8_t *data,
+		uint8_t len, int8_t res){
+
+	uint8_t *rec;
+	uint32_t ts = IS_NULL(Rec->clock) ? 0 : Rec->clock();
+
+	if( (Rec->size - Rec->len) < (uint32_t)(BME280_REC_LEN + len) ){
+
+		Rec->dropped++;
+		return;
+	}
+
+	rec = &Rec->buff[Rec->len];
+	rec[0] = (0 != res) ? (uint8_t)(type | BME280_REC_FAILED) : type;
+	rec[1] = reg_addr;
+	rec[2] = len;
+	rec[3] = (uint8_t)ts;
+	rec[4] = (uint8_t)(ts >> 8);
+	rec[5] = (uint8_t)(ts >> 16);
+	rec[6] = (uint8_t)(ts >> 24);
+	memcpy(&rec[BME280_REC_LEN], data, len);
+
+	Rec->len += BME280_REC_LEN + len;
+}
+
+	/* function takes next record from trace if it matches */
+static const uint8_t *bme280_rep_next(BME280_Replay_t *Rep, uint8_t type, uint8_t reg_addr, uint8_t len){
+
+	const uint8_t *rec = &Rep->buff[Rep->pos];
+
+	/* end of trace or different operation */
+	if( ((Rep->len - Rep->pos) < (uint32_t)(BME280_REC_LEN + len)) || ((rec[0] & ~BME280_REC_FAILED) != type) ||
+			(rec[1] != reg_addr) || (rec[2] != len) ){
+
+		Rep->mismatches++;
+		return NULL;
+	}
+
+	Rep->pos += BME280_REC_LEN + len;
+
+	return rec;
+}
+
+	/* recorder read function */
+static int8_t bme280_rec_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Recorder_t *rec = (BME280_Recorder_t *)((BME280_Driver_t *)driver)->env_spec_data;
+	int8_t res;
+
+	res = rec->target->read(reg_addr, rxbuff, rxlen, rec->target);
+	bme280_rec_append(rec, BME280_REC_READ, reg_addr, rxbuff, rxlen, res);
+
+	return res;
+}
+
+	/* recorder write function */
+static int8_t bme280_rec_write(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Recorder_t *rec = (BME280_Recorder_t *)((BME280_Driver_t *)driver)->env_spec_data;
+	int8_t res;
+
+	res = rec->target->write(reg_addr, value, rec->target);
+	bme280_rec_append(rec, BME280_REC_WRITE, reg_addr, &value, 1, res);
+
+	return res;
+}
+
+	/* recorder burst write function, pairs are stored as single writes */
+static int8_t bme280_rec_write_burst(const uint8_t *pairs, uint8_t count, void *driver){
+
+	BME280_Recorder_t *rec = (BME280_Recorder_t *)((BME280_Driver_t *)driver)->env_spec_data;
+	int8_t res;
+	uint8_t i;
+
+	res = rec->target->write_burst(pairs, count, rec->target);
+	for(i = 0; i < count; i++){
+
+		bme280_rec_append(rec, BME280_REC_WRITE, pairs[2 * i], &pairs[(2 * i) + 1], 1, res);
+	}
+
+	return res;
+}
+
+	/* recorder transfer function, operations are stored as single reads and writes */
+static int8_t bme280_rec_transfer(const BME280_Op_t *ops, uint8_t count, void *driver){
+
+	BME280_Recorder_t *rec = (BME280_Recorder_t *)((BME280_Driver_t *)driver)->env_spec_data;
+	int8_t res;
+	uint8_t i;
+
+	res = rec->target->transfer(ops, count, rec->target);
+	for(i = 0; i < count; i++){
+
+		if(BME280_OP_READ == ops[i].type){
+
+			bme280_rec_append(rec, BME280_REC_READ, ops[i].reg_addr, ops[i].rxbuff, ops[i].len, res);
+		}
+		else if(BME280_OP_WRITE == ops[i].type){
+
+			bme280_rec_append(rec, BME280_REC_WRITE, ops[i].reg_addr, &ops[i].value, 1, res);
+		}
+	}
+
+	return res;
+}
+
+	/* function serves single read from trace */
+static int8_t bme280_rep_read_op(BME280_Replay_t *Rep, uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen){
+
+	const uint8_t *rec;
+
+	rec = bme280_rep_next(Rep, BME280_REC_READ, reg_addr, rxlen);
+	if( IS_NULL(rec) ) return -1;
+
+	memcpy(rxbuff, &rec[BME280_REC_LEN], rxlen);
+
+	/* recorded failure is returned again */
+	return (0 != (rec[0] & BME280_REC_FAILED)) ? -1 : 0;
+}
+
+	/* function serves single write from trace */
+static int8_t bme280_rep_write_op(BME280_Replay_t *Rep, uint8_t reg_addr, uint8_t value){
+
+	const uint8_t *rec;
+
+	rec = bme280_rep_next(Rep, BME280_REC_WRITE, reg_addr, 1);
+	if( IS_NULL(rec) ) return -1;
+
+	/* different value written */
+	if(rec[BME280_REC_LEN] != value){
+
+		Rep->mismatches++;
+		return -1;
+	}
+
+	return (0 != (rec[0] & BME280_REC_FAILED)) ? -1 : 0;
+}
+
+	/* function adds simulated time of single transaction */
+static void bme280_rep_charge(BME280_Replay_t *Rep, uint8_t write, uint8_t n, uint8_t overhead){
+
+	uint32_t time = 0;
+	int8_t res;
+
+	if( IS_NULL(Rep->bus) ) return;
+
+	if(write) res = BME280_BusTimeWrite(Rep->bus, n, &time);
+	else res = BME280_BusTimeRead(Rep->bus, n, &time);
+	if(BME280_OK != res) return;
+	if(0 == overhead) time -= Rep->bus->overhead_ns;
+
+	/* keep full miliseconds separately, so long replays don't overflow */
+	Rep->bus_ns += time;
+	Rep->bus_ms += Rep->bus_ns / 1000000UL;
+	Rep->bus_ns %= 1000000UL;
+}
+
+	/* replay read function */
+static int8_t bme280_rep_read(uint8_t reg_addr, uint8_t *rxbuff, uint8_t rxlen, void *driver){
+
+	BME280_Replay_t *rep = (BME280_Replay_t *)((BME280_Driver_t *)driver)->env_spec_data;
+
+	bme280_rep_charge(rep, 0, rxlen, 1);
+
+	return bme280_rep_read_op(rep, reg_addr, rxbuff, rxlen);
+}
+
+	/* replay write function */
+static int8_t bme280_rep_write(uint8_t reg_addr, uint8_t value, void *driver){
+
+	BME280_Replay_t *rep = (BME280_Replay_t *)((BME280_Driver_t *)driver)->env_spec_data;
+
+	bme280_rep_charge(rep, 1, 1, 1);
+
+	return bme280_rep_write_op(rep, reg_addr, value);
+}
+
+	/* replay burst write function, all pairs are sent in single transaction */
+static int8_t bme280_rep_write_burst(const uint8_t *pairs, uint8_t count, void *driver){
+
+	BME280_Replay_t *rep = (BME280_Replay_t *)((BME280_Driver_t *)driver)->env_spec_data;
+	int8_t res = 0;
+	uint8_t i;
+
+	bme280_rep_charge(rep, 1, count, 1);
+
+	for(i = 0; (i < count) && (0 == res); i++) res = bme280_rep_write_op(rep, pairs[2 * i], pairs[(2 * i) + 1]);
+
+	return res;
+}
+
+	/* replay transfer function, platform function is called once for all operations */
+static int8_t bme280_rep_transfer(const BME280_Op_t *ops, uint8_t count, void *driver){
+
+	BME280_Replay_t *rep = (BME280_Replay_t *)((BME280_Driver_t *)driver)->env_spec_data;
+	int8_t res = 0;
+	uint8_t i;
+
+	for(i = 0; (i < count) && (0 == res); i++){
+
+		switch(ops[i].type){
+
+		case BME280_OP_WRITE:
+			bme280_rep_charge(rep, 1, 1, (0 == i));
+			res = bme280_rep_write_op(rep, ops[i].reg_addr, ops[i].value);
+			break;
+
+		case BME280_OP_READ:
+			bme280_rep_charge(rep, 0, ops[i].len, (0 == i));
+			res = bme280_rep_read_op(rep, ops[i].reg_addr, ops[i].rxbuff, ops[i].len);
+			break;
+
+		case BME280_OP_DELAY:
+			rep->wait_ms += ops[i].value;
+			break;
+
+		default:
+			res = -1;
+			break;
+		}
+	}
+
+	return res;
+}
+
+	/* replay delay function, trace is served at full speed */
+static void bme280_rep_delay(uint8_t delay_time){
+
+	(void)delay_time;
+}
+
+	/* function calculates wire time of transaction */
+static int8_t bme280_bus_time(const BME280_BusTiming_t *Bus, uint32_t bytes, uint8_t restart, uint32_t *Time){
+
+	uint32_t khz10 = Bus->clock_hz / 10000UL;
+	uint32_t hd_sta, su_sta, su_sto, buf, start;
+
+	if(0 == khz10) return BME280_PARAM_ERR;
+
+	/* SPI: 8 bits per byte and chip select, bit time is 100000 / (clock / 10000) ns */
+	if(BME280_BUS_SPI == Bus->type){
+
+		if(Bus->clock_hz > 10000000UL) return BME280_PARAM_ERR;
+
+		*Time = ((8UL * bytes * 100000UL) / khz10) + BME280_BUS_SPI_CS_NS;
+		return BME280_OK;
+	}
+
+	if( (BME280_BUS_I2C != Bus->type) || (Bus->clock_hz > 3400000UL) ) return BME280_PARAM_ERR;
+
+	/* min. times of START hold, repeated START setup, STOP setup and bus free time for speed mode */
+	if(Bus->clock_hz <= 100000UL){
+
+		hd_sta = 4000; su_sta = 4700; su_sto = 4000; buf = 4700;
+	}
+	else if(Bus->clock_hz <= 400000UL){
+
+		hd_sta = 600; su_sta = 600; su_sto = 600; buf = 1300;
+	}
+	else if(Bus->clock_hz <= 1000000UL){
+
+		hd_sta = 260; su_sta = 260; su_sto = 260; buf = 500;
+	}
+	else{
+
+		/* high speed mode: START and master code (8 bits + NACK) in fast mode, then repeated START,
+		 * bus returns to fast mode after STOP */
+		hd_sta = 160; su_sta = 160; su_sto = 160; buf = 1300;
+	}
+
+	start = hd_sta;
+	if(Bus->clock_hz > 1000000UL) start = 600UL + ((9UL * 100000UL) / 40UL) + su_sta + hd_sta;
+
+	/* 9 bits per byte (8 data bits and ACK) */
+	*Time = start + ((9UL * bytes * 100000UL) / khz10) + su_sto + buf;
+	if(restart) *Time += su_sta + hd_sta;
+
+	return BME280_OK;
+}
+
+///@}
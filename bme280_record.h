@@ -0,0 +1,219 @@
+/**
+ *******************************************
+ * @file    bme280_record.h
+ * @author  Łukasz Juraszek / JuraszekL
+ * @date	20.04.2023
+ * @brief   Header for BME280 bus recorder and replay
+ * @note 	https://github.com/JuraszekL/BME280_Driver
+ *******************************************
+*/
+
+/**
+ * @addtogroup BME280_Driver
+ * @{
+ */
+
+//***************************************
+
+#ifndef BME280_RECORD_H
+#define BME280_RECORD_H
+
+//***************************************
+
+#ifdef __cplusplus /* CPP */
+extern "C" {
+#endif
+
+//***************************************
+
+#include <stdint.h>
+#include "bme280.h"
+
+#ifdef USE_STATIC_BUS
+#error "bme280_record.h requires bus functions called via BME280_Driver_t pointers (USE_STATIC_BUS not set)"
+#endif
+
+/**
+ * @defgroup BME280_record Recorder and Replay
+ * @brief Record bus traffic of sensor and serve it back without hardware
+ *
+ * Recorder is placed between driver and platform specific functions: #BME280_RecorderInit fills #BME280_Driver_t
+ * passed later to #BME280_Init with own functions, which call functions of real driver and append every read and
+ * write to user buffer. Buffer can be saved as file and loaded back with #BME280_ReplayInit, which fills
+ * #BME280_Driver_t with functions serving recorded data with no delays. Driver must issue the same reads and
+ * writes in the same order, otherwise replay functions return error and count mismatch - so replay can be used
+ * to check equivalence of driver versions as well.
+ *
+ * Trace starts with 5 bytes header (#BME280_REC_MAGIC and #BME280_REC_VERSION), then records follow:
+ * type (1 byte), register address (1 byte), lenght of data (1 byte), timestamp (4 bytes, little endian) and data.
+ * Write is stored as single byte of data. Delays are not recorded. Burst writes and lists of operations are
+ * stored as single writes and reads, so trace recorded with #bme280_writeburst or #bme280_transfer functions
+ * can be replayed without them.
+ *
+ * Replay can charge simulated wire time of every transaction (see #BME280_BusTiming_t): start and stop
+ * conditions, addressing, ACK bits and data bytes for I2C speed modes, or data bits and chip select for SPI.
+ * Replay serves #bme280_writeburst and #bme280_transfer functions, so time is charged for transactions exactly
+ * as driver issues them, and delays inside lists of operations are counted as measurement wait time.
+ * @note bme280_record.c must be compiled together with bme280.c, #USE_STATIC_BUS can't be used
+ * @{
+ */
+
+/**
+ * @defgroup BME280_recdefs Definitions
+ * @{
+ */
+#define BME280_REC_MAGIC		(0x30383242UL)	///< first 4 bytes of trace ("B280" in little endian)
+#define BME280_REC_VERSION		(0x01U)		///< format version, 5th byte of trace
+#define BME280_REC_HEADER_LEN	(5U)		///< lenght of trace header
+#define BME280_REC_LEN			(7U)		///< lenght of record without data
+
+#define BME280_REC_READ			(0x01U)		///< record type - read registers
+#define BME280_REC_WRITE		(0x02U)		///< record type - write single register
+#define BME280_REC_FAILED		(0x80U)		///< OR-ed with record type if user function returned error
+
+#define BME280_BUS_I2C			(0x00U)		///< bus type - I2C, up to 3.4MHz
+#define BME280_BUS_SPI			(0x01U)		///< bus type - SPI, up to 10MHz
+
+#ifndef BME280_BUS_SPI_CS_NS
+#define BME280_BUS_SPI_CS_NS	(100U)		///< SPI chip select setup, hold and idle time per transaction (in ns)
+#endif
+///@}
+
+/**
+ * @struct BME280_BusTiming_t
+ * @brief Timing model of bus
+ *
+ * I2C timing follows minimal values of I2C specification for clock frequency: standard mode up to 100kHz,
+ * fast mode up to 400kHz, fast mode plus up to 1MHz and high speed mode above (master code is sent in fast mode
+ * before every transaction). Read takes START, address, register, repeated START, address, data and STOP, write
+ * takes START, address, (register, value) pairs and STOP, every byte with ACK bit.
+ * @{
+ */
+typedef struct {
+
+	uint8_t type;			///< #BME280_BUS_I2C or #BME280_BUS_SPI
+	uint32_t clock_hz;		///< clock frequency in Hz, 10kHz..3.4MHz for I2C, 10kHz..10MHz for SPI
+	uint32_t overhead_ns;	///< time of platform function added to every call (f.e. system call), can be 0
+
+} BME280_BusTiming_t;
+///@}
+
+/**
+ * @struct BME280_Recorder_t
+ * @brief Keeps state of recorder
+ * @{
+ */
+typedef struct {
+
+	/// driver with platform specific functions of real sensor
+	BME280_Driver_t *target;
+	/// (optional) pointer to user defined clock function used for timestamps, can be NULL
+	bme280_clock clock;
+	/// buffer where trace is stored
+	uint8_t *buff;
+	/// size of buffer (in bytes)
+	uint32_t size;
+	/// lenght of trace stored in buffer so far (in bytes)
+	uint32_t len;
+	/// number of records that didn't fit into buffer
+	uint32_t dropped;
+
+} BME280_Recorder_t;
+///@}
+
+/**
+ * @struct BME280_Replay_t
+ * @brief Keeps state of replay
+ * @{
+ */
+typedef struct {
+
+	/// recorded trace
+	const uint8_t *buff;
+	/// lenght of trace (in bytes)
+	uint32_t len;
+	/// position of next record
+	uint32_t pos;
+	/// number of reads and writes which didn't match trace
+	uint32_t mismatches;
+	/// (optional) bus timing model, can be set after #BME280_ReplayInit, NULL if wire time is not simulated
+	const BME280_BusTiming_t *bus;
+	/// simulated wire time, full miliseconds
+	uint32_t bus_ms;
+	/// simulated wire time, nanoseconds below full milisecond
+	uint32_t bus_ns;
+	/// simulated wait time of measurements (delays inside lists of operations) in miliseconds
+	uint32_t wait_ms;
+
+} BME280_Replay_t;
+///@}
+
+/**
+ * @brief Function prepares recorder
+ *
+ * Function writes trace header to buffer and fills *Driver with recorder functions. Optional write_burst and
+ * transfer functions are used only if they are set in *Target. Use *Driver with #BME280_Init (or other init
+ * function) instead of *Target. Fields "i2c_address" and "delay" are copied from *Target.
+ * @param[out] *Rec pointer to recorder structure, "clock" member must be set before (or NULL)
+ * @param[out] *Driver pointer to driver structure to be used with sensor
+ * @param[in] *Target pointer to driver structure with platform specific functions
+ * @param[out] *Buff pointer to buffer for trace
+ * @param[in] Size size of buffer, at least #BME280_REC_HEADER_LEN
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed
+ */
+int8_t BME280_RecorderInit(BME280_Recorder_t *Rec, BME280_Driver_t *Driver, BME280_Driver_t *Target,
+		uint8_t *Buff, uint32_t Size);
+
+/**
+ * @brief Function prepares replay
+ *
+ * Function checks trace header and fills *Driver with replay functions (delay function does nothing). Use
+ * *Driver with #BME280_Init (or other init function).
+ * @param[out] *Rep pointer to replay structure
+ * @param[out] *Driver pointer to driver structure to be used with sensor
+ * @param[in] *Buff pointer to recorded trace
+ * @param[in] Len lenght of trace (in bytes)
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed or trace header is wrong
+ */
+int8_t BME280_ReplayInit(BME280_Replay_t *Rep, BME280_Driver_t *Driver, const uint8_t *Buff, uint32_t Len);
+
+/**
+ * @brief Function calculates time of register read
+ *
+ * Function calculates time of single read transaction of "Len" bytes (see #BME280_BusTiming_t), including
+ * overhead of platform function.
+ * @param[in] *Bus pointer to timing model
+ * @param[in] Len lenght of data to read (in bytes)
+ * @param[out] *Time pointer to variable where time in nanoseconds will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed or clock frequency out of range
+ */
+int8_t BME280_BusTimeRead(const BME280_BusTiming_t *Bus, uint8_t Len, uint32_t *Time);
+
+/**
+ * @brief Function calculates time of register write
+ *
+ * Function calculates time of single write transaction with "Count" (register, value) pairs (see
+ * #BME280_BusTiming_t), including overhead of platform function.
+ * @param[in] *Bus pointer to timing model
+ * @param[in] Count number of registers to write
+ * @param[out] *Time pointer to variable where time in nanoseconds will be stored
+ * @return #BME280_OK success
+ * @return #BME280_PARAM_ERR wrong parameter passed or clock frequency out of range
+ */
+int8_t BME280_BusTimeWrite(const BME280_BusTiming_t *Bus, uint8_t Count, uint32_t *Time);
+///@}
+
+//***************************************
+
+#ifdef __cplusplus /* CPP */
+}
+#endif
+
+//***************************************
+
+#endif /* BME280_RECORD_H */
+
+///@}